@@ -1,4 +1,11 @@
+#include "bigint/accumulator.hpp"
+#include "bigint/async.hpp"
+#include "bigint/batch.hpp"
+#include "bigint/fixed_int.hpp"
 #include "bigint/bigint.hpp"
+#include "bigint/lazy.hpp"
+#include "bigint/modular.hpp"
+#include "bigint/shared_bigint.hpp"
 
 #include <benchmark/benchmark.h>
 
@@ -233,6 +240,166 @@ static void BM_BigInt_Multiplication(benchmark::State& state)
 }
 BENCHMARK(BM_BigInt_Multiplication);
 
+// Operands of 2^16 chunks, multiplied serially (threads = 1) and on every hardware thread (threads = 0).
+static void BM_BigInt_LargeMultiplication(benchmark::State& state)
+{
+    static BigInt const lhs = (3_bi).pow(2'600'000);
+    static BigInt const rhs = (7_bi).pow(1'480'000);
+    ExecutionPolicy const policy{.threads = static_cast<size_t>(state.range(0))};
+
+    for (auto _ : state)
+    {
+        BigInt c = multiply(lhs, rhs, policy);
+        benchmark::DoNotOptimize(c);
+    }
+}
+BENCHMARK(BM_BigInt_LargeMultiplication)->Arg(1)->Arg(0)->Unit(benchmark::kMillisecond);
+
+static std::vector<BigInt> const many_values = []
+{
+    std::vector<BigInt> values;
+
+    for (std::int64_t i = 1; i <= 100'000; ++i)
+    {
+        values.emplace_back(i % 2 == 0 ? i * 2'654'435'761 : -i * 40'503);
+    }
+
+    return values;
+}();
+
+static void BM_BigInt_reduce_product(benchmark::State& state)
+{
+    ExecutionPolicy const policy{.threads = static_cast<size_t>(state.range(0))};
+
+    for (auto _ : state)
+    {
+        BigInt c = reduce_product(many_values, policy);
+        benchmark::DoNotOptimize(c);
+    }
+}
+BENCHMARK(BM_BigInt_reduce_product)->Arg(1)->Arg(0)->Unit(benchmark::kMillisecond);
+
+static void BM_BigInt_reduce_sum(benchmark::State& state)
+{
+    ExecutionPolicy const policy{.threads = static_cast<size_t>(state.range(0))};
+
+    for (auto _ : state)
+    {
+        BigInt c = reduce_sum(many_values, policy);
+        benchmark::DoNotOptimize(c);
+    }
+}
+BENCHMARK(BM_BigInt_reduce_sum)->Arg(1)->Arg(0);
+
+static void BM_BigInt_Accumulator(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        Accumulator accumulator;
+
+        for (BigInt const &value : many_values)
+        {
+            accumulator += value;
+        }
+
+        BigInt c = accumulator.result();
+        benchmark::DoNotOptimize(c);
+    }
+}
+BENCHMARK(BM_BigInt_Accumulator);
+
+// 4096 lanes of 256 bits.
+static auto const batch_values = []
+{
+    std::vector<BigInt> values;
+
+    for (std::int64_t i = 1; i <= 4096; ++i)
+    {
+        values.push_back((BigInt(i) * (111_bi).pow(36)) % (1_bi << 256));
+    }
+
+    return values;
+}();
+
+static void BM_Batch_add(benchmark::State& state)
+{
+    Batch<4> const lhs(batch_values);
+
+    for (auto _ : state)
+    {
+        Batch<4> c = lhs + lhs;
+        benchmark::DoNotOptimize(c);
+    }
+}
+BENCHMARK(BM_Batch_add);
+
+static void BM_Batch_mul(benchmark::State& state)
+{
+    Batch<4> const lhs(batch_values);
+
+    for (auto _ : state)
+    {
+        Batch<8> c = wide_multiply(lhs, lhs);
+        benchmark::DoNotOptimize(c);
+    }
+}
+BENCHMARK(BM_Batch_mul);
+
+static void BM_FixedInt_mul(benchmark::State& state)
+{
+    FixedInt<256> const lhs = FixedInt<256>::max() / FixedInt<256>(3);
+    FixedInt<256> const rhs(12'345'678'901'234'567ULL);
+
+    for (auto _ : state)
+    {
+        FixedInt<256> c = lhs * rhs;
+        benchmark::DoNotOptimize(c);
+    }
+}
+BENCHMARK(BM_FixedInt_mul);
+
+// r = a * 3 + b evaluated eagerly (0) and as a lazy expression reusing the storage of r (1).
+static void BM_BigInt_multiply_add(benchmark::State& state)
+{
+    BigInt r;
+
+    for (auto _ : state)
+    {
+        if (state.range(0) == 0)
+        {
+            r = a * BigInt(3) + b;
+        }
+        else
+        {
+            r = lazy(a) * 3 + b;
+        }
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BM_BigInt_multiply_add)->Arg(0)->Arg(1);
+
+// Copy of a number of 2^16 chunks as a BigInt (0) and as a SharedBigInt (1).
+static void BM_BigInt_copy(benchmark::State& state)
+{
+    static BigInt const value = (3_bi).pow(2'600'000);
+    SharedBigInt const shared(value);
+
+    for (auto _ : state)
+    {
+        if (state.range(0) == 0)
+        {
+            BigInt c = value;
+            benchmark::DoNotOptimize(c);
+        }
+        else
+        {
+            SharedBigInt c = shared;
+            benchmark::DoNotOptimize(c);
+        }
+    }
+}
+BENCHMARK(BM_BigInt_copy)->Arg(0)->Arg(1);
+
 static void BM_BigInt_Division(benchmark::State& state)
 {
     for (auto _ : state)
@@ -263,4 +430,200 @@ static void BM_BigInt_Power(benchmark::State& state)
 }
 BENCHMARK(BM_BigInt_Power);
 
+static void BM_BigInt_gcd(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        BigInt c = gcd(a, b);
+        benchmark::DoNotOptimize(c);
+    }
+}
+BENCHMARK(BM_BigInt_gcd);
+
+static void BM_BigInt_gcdext(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        auto c = gcdext(a, b);
+        benchmark::DoNotOptimize(c);
+    }
+}
+BENCHMARK(BM_BigInt_gcdext);
+
+static void BM_BigInt_powm(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        BigInt c = powm(b, a, m);
+        benchmark::DoNotOptimize(c);
+    }
+}
+BENCHMARK(BM_BigInt_powm);
+
+static void BM_BigInt_powm_sec(benchmark::State& state)
+{
+    BigInt const odd_m = m + 1_bi;
+
+    for (auto _ : state)
+    {
+        BigInt c = powm_sec(b, a, odd_m);
+        benchmark::DoNotOptimize(c);
+    }
+}
+BENCHMARK(BM_BigInt_powm_sec);
+
+static void BM_BigInt_invert(benchmark::State& state)
+{
+    // 2^2203 - 1 is prime, so every value is invertible.
+    BigInt const prime = (1_bi << 2203) - 1_bi;
+
+    for (auto _ : state)
+    {
+        for (BigInt value = b; value < b + 100_bi; value += 1_bi)
+        {
+            BigInt c = invert(value, prime);
+            benchmark::DoNotOptimize(c);
+        }
+    }
+}
+BENCHMARK(BM_BigInt_invert);
+
+static void BM_BigInt_batch_invert(benchmark::State& state)
+{
+    BigInt const prime = (1_bi << 2203) - 1_bi;
+    std::vector<BigInt> values;
+
+    for (BigInt value = b; value < b + 100_bi; value += 1_bi)
+    {
+        values.push_back(value);
+    }
+
+    for (auto _ : state)
+    {
+        std::vector<BigInt> c = values;
+        batch_invert(c, prime);
+        benchmark::DoNotOptimize(c);
+    }
+}
+BENCHMARK(BM_BigInt_batch_invert);
+
+static void BM_BigInt_isqrt(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        BigInt c = isqrt(a);
+        benchmark::DoNotOptimize(c);
+    }
+}
+BENCHMARK(BM_BigInt_isqrt);
+
+static void BM_BigInt_root(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        BigInt c = root(a, 7);
+        benchmark::DoNotOptimize(c);
+    }
+}
+BENCHMARK(BM_BigInt_root);
+
+static void BM_BigInt_is_perfect_power(benchmark::State& state)
+{
+    BigInt const c = a + 1_bi;
+
+    for (auto _ : state)
+    {
+        bool d = is_perfect_power(c);
+        benchmark::DoNotOptimize(d);
+    }
+}
+BENCHMARK(BM_BigInt_is_perfect_power);
+
+static void BM_BigInt_is_probable_prime(benchmark::State& state)
+{
+    // 2^2203 - 1 is prime, so every test runs in full.
+    BigInt const prime = (1_bi << 2203) - 1_bi;
+
+    for (auto _ : state)
+    {
+        bool c = is_probable_prime(prime);
+        benchmark::DoNotOptimize(c);
+    }
+}
+BENCHMARK(BM_BigInt_is_probable_prime);
+
+static void BM_BigInt_next_prime(benchmark::State& state)
+{
+    BigInt const c = (1_bi << 1023) + 1_bi;
+
+    for (auto _ : state)
+    {
+        BigInt d = next_prime(c);
+        benchmark::DoNotOptimize(d);
+    }
+}
+BENCHMARK(BM_BigInt_next_prime);
+
+static void BM_BigInt_factorial(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        BigInt c = factorial(20000);
+        benchmark::DoNotOptimize(c);
+    }
+}
+BENCHMARK(BM_BigInt_factorial);
+
+// Factorial with products of up to 10^4 chunks, computed directly (0) and by factorial_async (1), which checks for a
+// stop request and reports its progress.
+static void BM_BigInt_factorial_async(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        BigInt c = state.range(0) == 0 ? factorial(60000) : factorial_async(60000, {}, [](double) {}).get();
+        benchmark::DoNotOptimize(c);
+    }
+}
+BENCHMARK(BM_BigInt_factorial_async)->Arg(0)->Arg(1);
+
+static void BM_BigInt_binomial(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        BigInt c = binomial(40000, 20000);
+        benchmark::DoNotOptimize(c);
+    }
+}
+BENCHMARK(BM_BigInt_binomial);
+
+// m + 1 has 2106 bits.
+static constexpr size_t mod_chunks = (2106 + sizeof(BigInt::ChunkType) * 8 - 1) / (sizeof(BigInt::ChunkType) * 8);
+
+static void BM_ModInt_mul(benchmark::State& state)
+{
+    ModContext<mod_chunks> const context(m + 1_bi);
+    ModInt<mod_chunks> c(context, a);
+    ModInt<mod_chunks> const d(context, b);
+
+    for (auto _ : state)
+    {
+        c *= d;
+        benchmark::DoNotOptimize(c);
+    }
+}
+BENCHMARK(BM_ModInt_mul);
+
+static void BM_ModInt_pow(benchmark::State& state)
+{
+    ModContext<mod_chunks> const context(m + 1_bi);
+    ModInt<mod_chunks> const d(context, b);
+
+    for (auto _ : state)
+    {
+        ModInt<mod_chunks> c = d.pow(a);
+        benchmark::DoNotOptimize(c);
+    }
+}
+BENCHMARK(BM_ModInt_pow);
+
 BENCHMARK_MAIN();
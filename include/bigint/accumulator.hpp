@@ -0,0 +1,90 @@
+#pragma once
+
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "bigint.hpp"
+
+namespace BI
+{
+/// @brief Sum of many numbers that defers the carries until the result is needed.
+///
+/// Every chunk of the sum has a second chunk that counts the carries out of it, so adding a number only touches as
+/// many chunks as it has and the chunks don't depend on each other, which lets the compiler vectorize the loop.
+/// Positive and negative numbers are summed separately and subtracted once by result(). Accumulators filled by
+/// different threads can be merged.
+class Accumulator
+{
+public:
+    using ChunkType = BigInt::ChunkType;
+
+    /// @brief Construct an accumulator with a sum of 0.
+    Accumulator() = default;
+
+    /// @brief Add a number.
+    auto operator+=(BigIntView value) -> Accumulator &
+    {
+        (value.is_negative() ? negative : positive).add(value.chunks());
+        return *this;
+    }
+
+    /// @brief Subtract a number.
+    auto operator-=(BigIntView value) -> Accumulator &
+    {
+        (value.is_negative() ? positive : negative).add(value.chunks());
+        return *this;
+    }
+
+    /// @brief Add the sum of another accumulator, for example one filled by another thread.
+    auto merge(Accumulator const &other) -> Accumulator &;
+
+    /// @brief Get the sum, propagating the pending carries.
+    [[nodiscard]] auto result() const -> BigInt;
+
+    /// @brief Reset the sum to 0, keeping the allocated buffers.
+    void clear() noexcept;
+
+private:
+    /// @brief Carry-save sum of magnitudes.
+    class Lanes
+    {
+    public:
+        /// @brief Add a magnitude.
+        void add(std::span<ChunkType const> chunks)
+        {
+            if (chunks.size() > low.size() || additions == std::numeric_limits<ChunkType>::max())
+            {
+                grow(chunks.size());
+            }
+
+            ++additions;
+
+            for (size_t i = 0; i < chunks.size(); ++i)
+            {
+                low[i] += chunks[i];
+                carries[i] += static_cast<ChunkType>(low[i] < chunks[i]);
+            }
+        }
+
+        /// @brief Get the chunks of the sum with the carries propagated, with leading zeroes.
+        [[nodiscard]] auto normalize() const -> std::vector<ChunkType>;
+
+        void clear() noexcept;
+
+    private:
+        /// @brief Chunks of the sum without the carries.
+        std::vector<ChunkType> low;
+        /// @brief Number of carries out of every chunk.
+        std::vector<ChunkType> carries;
+        /// @brief Upper bound of every carry count, the carries are propagated before it can overflow.
+        ChunkType additions{0};
+
+        /// @brief Make room for a magnitude of the given size and propagate the carries if the counts may overflow.
+        void grow(size_t size);
+    };
+
+    Lanes positive;
+    Lanes negative;
+};
+}  // namespace BI
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+
+#include "bigint.hpp"
+
+namespace BI
+{
+/// @brief Read-only array of numbers stored in a single file.
+///
+/// The file holds a header, an index with the offset and sign of every number, and the chunks of all numbers packed
+/// together in the native byte order. It is memory-mapped when opened, so opening is O(1) regardless of the number of
+/// values and every element is a view into the mapping. Copies of the archive share the mapping, which stays valid as
+/// long as any copy is alive.
+///
+/// @note Archives can only be read on platforms with the same byte order and chunk size as the one that wrote them.
+class BigIntArchive
+{
+public:
+    /// @brief Open an archive file.
+    ///
+    /// @param path Path of the archive to open.
+    ///
+    /// @throws std::system_error if the file can't be opened or mapped.
+    /// @throws std::invalid_argument if the file isn't a valid archive for this platform.
+    explicit BigIntArchive(std::filesystem::path const &path);
+
+    /// @brief Write numbers to an archive file, replacing its contents.
+    ///
+    /// @param path Path of the archive to write.
+    /// @param values The numbers to store.
+    ///
+    /// @throws std::system_error if the file can't be opened or written.
+    static void write(std::filesystem::path const &path, std::span<BigInt const> values);
+
+    /// @brief Get the number of values in the archive.
+    [[nodiscard]] auto size() const noexcept -> size_t
+    {
+        return index.empty() ? 0 : index.size() - 1;
+    }
+
+    /// @brief Check if the archive holds no values.
+    [[nodiscard]] auto empty() const noexcept -> bool
+    {
+        return size() == 0;
+    }
+
+    /// @brief Get a view of the value at the given index, without bounds checking.
+    [[nodiscard]] auto operator[](size_t position) const noexcept -> BigIntView
+    {
+        // Every entry of the index is the chunk offset of a value shifted left by one, with the sign in the lowest bit.
+        auto const begin = static_cast<size_t>(index[position] >> 1);
+        auto const end = static_cast<size_t>(index[position + 1] >> 1);
+        return BigIntView(chunks.subspan(begin, end - begin), (index[position] & 1) != 0);
+    }
+
+    /// @brief Get a view of the value at the given index.
+    ///
+    /// @throws std::out_of_range if the index is out of range or the entry of the index is corrupted.
+    [[nodiscard]] auto at(size_t position) const -> BigIntView;
+
+private:
+    using ChunkType = BigInt::ChunkType;
+
+    /// @brief Owner of the memory of the archive, either a mapping of the file or a buffer holding its contents.
+    std::shared_ptr<void const> storage;
+    /// @brief Offsets and signs of the values, followed by the total number of chunks.
+    std::span<std::uint64_t const> index;
+    /// @brief Chunks of all values.
+    std::span<ChunkType const> chunks;
+};
+}  // namespace BI
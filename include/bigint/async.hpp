@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bigint.hpp"
+
+namespace BI
+{
+/// @brief Receives the estimated fraction of an asynchronous operation that is done, from 0 to 1.
+///
+/// It's called from the thread running the operation with increasing values, and a last time with 1 once the result is
+/// ready. The fraction comes from the estimated cost of every step, not from the elapsed time.
+using ProgressCallback = std::function<void(double)>;
+
+/// @brief Thrown by the future of an asynchronous operation that was stopped before its result was ready.
+class OperationCancelled : public std::runtime_error
+{
+public:
+    OperationCancelled() : std::runtime_error("Operation cancelled")
+    {
+    }
+};
+
+// Every asynchronous operation runs on its own thread, on copies of its operands. Large multiplications are split in
+// halves and divisions in blocks of quotient chunks, and the stop token is checked before every piece, so a stop
+// request is noticed within a few milliseconds and makes the future throw OperationCancelled. The future is the one of
+// std::async: destroying it waits for the operation, so request a stop first to abandon it.
+
+/// @brief Raise a number to a power on another thread.
+///
+/// @param base The number to raise.
+/// @param power The power, 0^0 is 1.
+/// @param stop Stops the operation when requested.
+/// @param progress Called with the progress of the operation, may be empty.
+/// @return The future of base^power.
+[[nodiscard]] auto pow_async(BigInt base, size_t power, std::stop_token stop = {}, ProgressCallback progress = {})
+    -> std::future<BigInt>;
+
+/// @brief Divide two numbers on another thread, rounding the quotient towards 0 like BigInt::div().
+///
+/// @param num The dividend.
+/// @param denom The divisor.
+/// @param stop Stops the operation when requested.
+/// @param progress Called with the progress of the operation, may be empty.
+/// @return The future of the quotient and the remainder, which throws std::domain_error if the divisor is 0.
+[[nodiscard]] auto div_async(BigInt num, BigInt denom, std::stop_token stop = {}, ProgressCallback progress = {})
+    -> std::future<std::pair<BigInt, BigInt>>;
+
+/// @brief Convert a number to a string on another thread, see BigInt::to_string().
+///
+/// @param num The number to convert.
+/// @param base The base to convert to, from 2 to 36.
+/// @param capitalize Whether to use uppercase letters for digits above 9.
+/// @param stop Stops the operation when requested.
+/// @param progress Called with the progress of the operation, may be empty.
+/// @return The future of the digits, which throws std::invalid_argument if the base is out of range.
+[[nodiscard]] auto to_string_async(
+    BigInt num,
+    int base = 10,
+    bool capitalize = false,
+    std::stop_token stop = {},
+    ProgressCallback progress = {}
+) -> std::future<std::string>;
+
+/// @brief Get the product of the integers in [first, last) on another thread, see product().
+///
+/// @param stop Stops the operation when requested.
+/// @param progress Called with the progress of the operation, may be empty.
+[[nodiscard]] auto product_async(
+    std::uint64_t first,
+    std::uint64_t last,
+    std::stop_token stop = {},
+    ProgressCallback progress = {}
+) -> std::future<BigInt>;
+
+/// @brief Get n! on another thread, see factorial().
+///
+/// @param stop Stops the operation when requested.
+/// @param progress Called with the progress of the operation, may be empty.
+[[nodiscard]] auto factorial_async(std::uint64_t n, std::stop_token stop = {}, ProgressCallback progress = {})
+    -> std::future<BigInt>;
+
+/// @brief Multiply many numbers on another thread, pairing neighbours in a balanced tree.
+///
+/// @param values The numbers to multiply.
+/// @param stop Stops the operation when requested.
+/// @param progress Called with the progress of the operation, may be empty.
+/// @return The future of the product, 1 if there are no numbers.
+[[nodiscard]] auto reduce_product_async(
+    std::vector<BigInt> values,
+    std::stop_token stop = {},
+    ProgressCallback progress = {}
+) -> std::future<BigInt>;
+}  // namespace BI
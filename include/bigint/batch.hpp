@@ -0,0 +1,346 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "bigint.hpp"
+
+namespace BI
+{
+/// @brief Many unsigned integers of Limbs chunks each, stored limb by limb.
+///
+/// Limb k of every lane is stored next to limb k of the neighbouring lanes (structure of arrays), so the operations run
+/// the same instruction over consecutive lanes with the carries of every lane kept in a small array. The inner loops
+/// have no dependency between lanes, which lets the compiler vectorize them for the instruction sets it targets, and
+/// the same code is the scalar fallback. Arithmetic wraps around modulo 2^(Limbs * chunk bits).
+///
+/// @tparam Limbs Number of chunks of every lane.
+template<size_t Limbs>
+class Batch
+{
+public:
+    static_assert(Limbs > 0, "Lanes must have at least one chunk");
+
+    using ChunkType = BigInt::ChunkType;
+
+    /// @brief Number of lanes processed together, their carries are kept on the stack.
+    static constexpr size_t block_lanes = 64;
+
+    /// @brief Construct a batch of lanes set to 0.
+    explicit Batch(size_t lanes = 0) : lane_count{lanes}, limbs(Limbs * lanes, 0)
+    {
+    }
+
+    /// @brief Construct a batch from numbers, one lane per number.
+    ///
+    /// @throws std::domain_error if a number is negative.
+    /// @throws std::overflow_error if a number doesn't fit in Limbs chunks.
+    explicit Batch(std::span<BigInt const> values) : Batch(values.size())
+    {
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            set(i, values[i]);
+        }
+    }
+
+    /// @brief Get the number of lanes.
+    [[nodiscard]] auto size() const noexcept -> size_t
+    {
+        return lane_count;
+    }
+
+    /// @brief Get limb k of every lane.
+    [[nodiscard]] auto limb(size_t k) noexcept -> std::span<ChunkType>
+    {
+        assert(k < Limbs);
+        return std::span(limbs).subspan(k * lane_count, lane_count);
+    }
+
+    /// @brief Get limb k of every lane.
+    [[nodiscard]] auto limb(size_t k) const noexcept -> std::span<ChunkType const>
+    {
+        assert(k < Limbs);
+        return std::span(limbs).subspan(k * lane_count, lane_count);
+    }
+
+    /// @brief Set a lane to a number.
+    ///
+    /// @throws std::out_of_range if the lane doesn't exist.
+    /// @throws std::domain_error if the number is negative.
+    /// @throws std::overflow_error if the number doesn't fit in Limbs chunks.
+    void set(size_t lane, BigIntView value)
+    {
+        if (lane >= lane_count)
+        {
+            throw std::out_of_range(std::format("Lane {} out of range for a batch of {} lanes", lane, lane_count));
+        }
+        if (value.is_negative())
+        {
+            throw std::domain_error("Batches only hold non-negative numbers");
+        }
+
+        std::span<ChunkType const> const chunks = value.chunks();
+
+        if (chunks.size() > Limbs)
+        {
+            throw std::overflow_error(std::format("Number doesn't fit in {} chunks", Limbs));
+        }
+
+        for (size_t k = 0; k < Limbs; ++k)
+        {
+            limbs[(k * lane_count) + lane] = k < chunks.size() ? chunks[k] : 0;
+        }
+    }
+
+    /// @brief Get the number in a lane.
+    ///
+    /// @throws std::out_of_range if the lane doesn't exist.
+    [[nodiscard]] auto get(size_t lane) const -> BigInt
+    {
+        if (lane >= lane_count)
+        {
+            throw std::out_of_range(std::format("Lane {} out of range for a batch of {} lanes", lane, lane_count));
+        }
+
+        std::array<ChunkType, Limbs> chunks{};
+
+        for (size_t k = 0; k < Limbs; ++k)
+        {
+            chunks[k] = limbs[(k * lane_count) + lane];
+        }
+
+        return BigInt(BigIntView(chunks));
+    }
+
+    /// @brief Get the numbers of every lane.
+    [[nodiscard]] auto values() const -> std::vector<BigInt>
+    {
+        std::vector<BigInt> result;
+        result.reserve(lane_count);
+
+        for (size_t i = 0; i < lane_count; ++i)
+        {
+            result.push_back(get(i));
+        }
+
+        return result;
+    }
+
+    /// @brief Add two batches lane by lane, modulo 2^(Limbs * chunk bits).
+    [[nodiscard]] friend auto operator+(Batch const &lhs, Batch const &rhs) -> Batch
+    {
+        return combine(
+            lhs,
+            rhs,
+            [](ChunkType a, ChunkType b, ChunkType &carry) noexcept
+            {
+                ChunkType const sum = a + b;
+                ChunkType const result = sum + carry;
+                carry = static_cast<ChunkType>(sum < a) | static_cast<ChunkType>(result < sum);
+                return result;
+            }
+        );
+    }
+
+    /// @brief Subtract two batches lane by lane, modulo 2^(Limbs * chunk bits).
+    [[nodiscard]] friend auto operator-(Batch const &lhs, Batch const &rhs) -> Batch
+    {
+        return combine(
+            lhs,
+            rhs,
+            [](ChunkType a, ChunkType b, ChunkType &borrow) noexcept
+            {
+                ChunkType const difference = a - b;
+                ChunkType const result = difference - borrow;
+                borrow = static_cast<ChunkType>(a < b) | static_cast<ChunkType>(difference < borrow);
+                return result;
+            }
+        );
+    }
+
+    /// @brief Multiply two batches lane by lane, modulo 2^(Limbs * chunk bits).
+    [[nodiscard]] friend auto operator*(Batch const &lhs, Batch const &rhs) -> Batch
+    {
+        return multiply<Limbs>(lhs, rhs);
+    }
+
+    auto operator+=(Batch const &rhs) -> Batch &
+    {
+        return *this = *this + rhs;
+    }
+
+    auto operator-=(Batch const &rhs) -> Batch &
+    {
+        return *this = *this - rhs;
+    }
+
+    auto operator*=(Batch const &rhs) -> Batch &
+    {
+        return *this = *this * rhs;
+    }
+
+    /// @brief Multiply two batches lane by lane without losing the high half of the products.
+    [[nodiscard]] friend auto wide_multiply(Batch const &lhs, Batch const &rhs) -> Batch<2 * Limbs>
+    {
+        return multiply<2 * Limbs>(lhs, rhs);
+    }
+
+    /// @brief Compare two batches lane by lane.
+    ///
+    /// @return The ordering of every lane of lhs relative to the same lane of rhs.
+    [[nodiscard]] friend auto compare(Batch const &lhs, Batch const &rhs) -> std::vector<std::strong_ordering>
+    {
+        check_sizes(lhs, rhs);
+
+        size_t const lanes = lhs.size();
+        // -1, 0 or 1 for every lane, only the most significant differing limb decides.
+        std::vector<std::int8_t> signs(lanes, 0);
+
+        for (size_t k = Limbs; k-- > 0;)
+        {
+            std::span<ChunkType const> const a = lhs.limb(k);
+            std::span<ChunkType const> const b = rhs.limb(k);
+
+            for (size_t i = 0; i < lanes; ++i)
+            {
+                int const limb_sign = static_cast<int>(a[i] > b[i]) - static_cast<int>(a[i] < b[i]);
+                signs[i] = signs[i] != 0 ? signs[i] : static_cast<std::int8_t>(limb_sign);
+            }
+        }
+
+        std::vector<std::strong_ordering> result;
+        result.reserve(lanes);
+
+        for (std::int8_t const sign : signs)
+        {
+            result.push_back(sign <=> 0);
+        }
+
+        return result;
+    }
+
+private:
+    size_t lane_count;
+    /// @brief Limb k of lane i is at k * lane_count + i.
+    std::vector<ChunkType> limbs;
+
+    static void check_sizes(Batch const &lhs, Batch const &rhs)
+    {
+        if (lhs.size() != rhs.size())
+        {
+            throw std::invalid_argument(
+                std::format("Batches have different numbers of lanes ({} and {})", lhs.size(), rhs.size())
+            );
+        }
+    }
+
+    /// @brief Multiply two limbs into a low and a high limb.
+    ///
+    /// Inlined 128-bit multiplication when the compiler has it, the loops calling it can't be vectorized otherwise.
+    [[nodiscard]] static auto multiply_limbs(ChunkType a, ChunkType b) noexcept -> std::pair<ChunkType, ChunkType>
+    {
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__SIZEOF_INT128__)
+        if constexpr (sizeof(ChunkType) == 8)
+        {
+            __uint128_t const result = static_cast<__uint128_t>(a) * b;
+            return {static_cast<ChunkType>(result), static_cast<ChunkType>(result >> 64)};
+        }
+#endif
+        if constexpr (sizeof(ChunkType) <= 4)
+        {
+            auto const result = static_cast<std::uint64_t>(a) * b;
+            return {static_cast<ChunkType>(result), static_cast<ChunkType>(result >> (sizeof(ChunkType) * 8))};
+        }
+
+        return BigInt::multiply_chunks(a, b);
+    }
+
+    /// @brief Combine two batches limb by limb from the least significant one, with a carry per lane.
+    ///
+    /// @param operation Called with the limbs of both batches and the carry of the lane, updates the carry and returns
+    ///                  the limb of the result.
+    template<typename Operation>
+    [[nodiscard]] static auto combine(Batch const &lhs, Batch const &rhs, Operation const &operation) -> Batch
+    {
+        check_sizes(lhs, rhs);
+
+        size_t const lanes = lhs.size();
+        Batch result(lanes);
+
+        for (size_t first = 0; first < lanes; first += block_lanes)
+        {
+            size_t const count = std::min(block_lanes, lanes - first);
+            std::array<ChunkType, block_lanes> carries{};
+
+            for (size_t k = 0; k < Limbs; ++k)
+            {
+                ChunkType const *const a = lhs.limb(k).data() + first;
+                ChunkType const *const b = rhs.limb(k).data() + first;
+                ChunkType *const r = result.limb(k).data() + first;
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    r[i] = operation(a[i], b[i], carries[i]);
+                }
+            }
+        }
+
+        return result;
+    }
+
+    /// @brief Multiply two batches lane by lane with schoolbook multiplication, keeping the lowest ResultLimbs limbs.
+    template<size_t ResultLimbs>
+    [[nodiscard]] static auto multiply(Batch const &lhs, Batch const &rhs) -> Batch<ResultLimbs>
+    {
+        check_sizes(lhs, rhs);
+
+        size_t const lanes = lhs.size();
+        Batch<ResultLimbs> result(lanes);
+
+        for (size_t first = 0; first < lanes; first += block_lanes)
+        {
+            size_t const count = std::min(block_lanes, lanes - first);
+
+            for (size_t j = 0; j < Limbs; ++j)
+            {
+                ChunkType const *const b = rhs.limb(j).data() + first;
+                std::array<ChunkType, block_lanes> carries{};
+
+                // Row j of the product, limbs j + k with k < Limbs, only the ones that are kept.
+                for (size_t k = 0; k < Limbs && j + k < ResultLimbs; ++k)
+                {
+                    ChunkType const *const a = lhs.limb(k).data() + first;
+                    ChunkType *const r = result.limb(j + k).data() + first;
+
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        auto [low, high] = multiply_limbs(a[i], b[i]);
+                        low += carries[i];
+                        high += static_cast<ChunkType>(low < carries[i]);
+                        r[i] += low;
+                        high += static_cast<ChunkType>(r[i] < low);
+                        carries[i] = high;
+                    }
+                }
+
+                if (j + Limbs < ResultLimbs)
+                {
+                    ChunkType *const r = result.limb(j + Limbs).data() + first;
+                    std::copy_n(carries.begin(), count, r);
+                }
+            }
+        }
+
+        return result;
+    }
+};
+}  // namespace BI
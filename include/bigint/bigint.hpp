@@ -1,21 +1,59 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <filesystem>
 #include <format>
+#include <functional>
+#include <iosfwd>
 #include <limits>
+#include <optional>
+#include <span>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <tuple>
 #include <type_traits>
 #include <vector>
 
+#include "execution.hpp"
 #include "utils.hpp"
 
 namespace BI
 {
+/// @brief How the sign of a number is stored in its binary representation.
+enum class Signedness : std::uint_fast8_t
+{
+    /// @brief Only the magnitude is stored, negative numbers can't be represented.
+    Unsigned,
+    /// @brief The magnitude is stored and the most significant bit is the sign.
+    SignMagnitude,
+    /// @brief The number is stored in two's complement.
+    TwosComplement
+};
+
+class BigIntView;
+class SharedBigInt;
+
+template<size_t Limbs>
+class Batch;
+
+namespace detail
+{
+class Montgomery;
+class LazyEvaluator;
+}  // namespace detail
+
 class BigInt
 {
 public:
+    /// @brief Type used for each chunk of the number.
+    using ChunkType = std::uint_fast32_t;
+
     BigInt();
     BigInt(BigInt const &rhs) = default;
     BigInt(BigInt &&rhs) noexcept = default;
@@ -35,11 +73,41 @@ public:
     }
 
     explicit BigInt(std::string_view num);
+
+    /// @brief Construct a number from its digits in the given base.
+    ///
+    /// @param num The digits of the number, optionally preceded by a minus sign. Base prefixes are not accepted.
+    /// @param base The base of the digits, from 2 to 36. Digits above 9 are the letters a-z in any case.
+    ///
+    /// @throws std::invalid_argument if the base is out of range or num contains invalid digits for the base.
+    BigInt(std::string_view num, int base);
+
+    /// @brief Construct a number by copying the value of a view.
+    explicit BigInt(BigIntView num);
+
+    /// @brief Construct a number by evaluating a lazy expression, see lazy().
+    template<typename Expression>
+        requires requires(Expression const &expression, BigInt &result) { expression.evaluate_to(result); }
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    BigInt(Expression const &expression)
+    {
+        expression.evaluate_to(*this);
+    }
+
     ~BigInt() = default;
 
     auto operator=(BigInt const &rhs) noexcept -> BigInt & = default;
     auto operator=(BigInt &&rhs) noexcept -> BigInt & = default;
 
+    /// @brief Evaluate a lazy expression into the number, reusing its storage. See lazy().
+    template<typename Expression>
+        requires requires(Expression const &expression, BigInt &result) { expression.evaluate_to(result); }
+    auto operator=(Expression const &expression) -> BigInt &
+    {
+        expression.evaluate_to(*this);
+        return *this;
+    }
+
     auto operator+() const noexcept -> BigInt;
     auto operator-() const noexcept -> BigInt;
 
@@ -119,6 +187,15 @@ public:
 
     explicit operator std::string() const;
 
+    /// @brief Convert the number to a string in the given base.
+    ///
+    /// @param base The base to convert to, from 2 to 36.
+    /// @param capitalize Whether to use uppercase letters for digits above 9.
+    /// @return The digits of the number, preceded by a minus sign if it's negative.
+    ///
+    /// @throws std::invalid_argument if the base is out of range.
+    [[nodiscard]] auto to_string(int base = 10, bool capitalize = false) const -> std::string;
+
     /// @brief Get the absolute value of the number.
     [[nodiscard]] auto abs() const noexcept -> BigInt;
 
@@ -164,7 +241,7 @@ public:
     /// @return The quotient and remainder.
     ///
     /// @throw std::domain_error if the divisor is 0.
-    [[nodiscard]] static auto div(BigInt const &num, BigInt const &denom) -> std::pair<BigInt, BigInt>;
+    [[nodiscard]] static auto div(BigIntView num, BigIntView denom) -> std::pair<BigInt, BigInt>;
 
     /// @brief Raise the number to the specified power.
     ///
@@ -175,13 +252,143 @@ public:
     /// @note 0^0 returns 1.
     [[nodiscard]] auto pow(size_t power) const noexcept -> BigInt;
 
-    friend std::formatter<BigInt>;
-    friend auto operator""_bi(char const *) -> BigInt;
+    /// @brief Read a number from a stream.
+    ///
+    /// Leading whitespace is skipped, then an optional sign and the digits of the number are read up to the first
+    /// character that isn't a valid digit, which is left in the stream. The digits are consumed through the stream
+    /// buffer in fixed-size blocks, so no copy of the whole input is ever made.
+    ///
+    /// @param is The stream to read from.
+    /// @param base The base of the digits, from 2 to 36. Base prefixes are not accepted.
+    /// @return The number that was read.
+    ///
+    /// @throws std::invalid_argument if the base is out of range or the stream doesn't start with a valid number, in
+    /// which case failbit is also set on the stream.
+    [[nodiscard]] static auto read(std::istream &is, int base = 10) -> BigInt;
 
-private:
-    /// @brief Type used for each chunk of the number.
-    using ChunkType = std::uint_fast32_t;
+    /// @brief Read a number from a file.
+    ///
+    /// On POSIX systems the file is memory-mapped and parsed in place, otherwise it is read as a stream. Leading and
+    /// trailing whitespace is ignored.
+    ///
+    /// @param path Path of the file to read.
+    /// @param base The base of the digits, from 2 to 36. Base prefixes are not accepted.
+    /// @return The number that was read.
+    ///
+    /// @throws std::system_error if the file can't be opened or mapped.
+    /// @throws std::invalid_argument if the base is out of range or the file doesn't contain a valid number.
+    [[nodiscard]] static auto from_file(std::filesystem::path const &path, int base = 10) -> BigInt;
 
+    /// @brief Write the number to a stream.
+    ///
+    /// Digits are written in fixed-size blocks as they are produced, so no string of the whole number is built. The
+    /// width, fill, adjustfield, showpos and showbase settings of the stream are respected.
+    ///
+    /// @param os The stream to write to.
+    /// @param base The base to write the number in, from 2 to 36.
+    /// @param capitalize Whether to use uppercase letters for digits above 9 and for the base prefix.
+    ///
+    /// @throws std::invalid_argument if the base is out of range.
+    void write(std::ostream &os, int base = 10, bool capitalize = false) const;
+
+    /// @brief Write the number to a file, replacing its contents.
+    ///
+    /// On POSIX systems the digits are written directly to the file descriptor in fixed-size blocks, otherwise they
+    /// are written through a file stream.
+    ///
+    /// @param path Path of the file to write.
+    /// @param base The base to write the number in, from 2 to 36.
+    /// @param capitalize Whether to use uppercase letters for digits above 9.
+    ///
+    /// @throws std::system_error if the file can't be opened or written.
+    /// @throws std::invalid_argument if the base is out of range.
+    void to_file(std::filesystem::path const &path, int base = 10, bool capitalize = false) const;
+
+    /// @brief Construct a number from its binary representation.
+    ///
+    /// @param bytes The bytes of the number. An empty span is 0.
+    /// @param endian The byte order of the bytes.
+    /// @param signedness How the sign is stored in the bytes.
+    /// @return The number represented by the bytes.
+    [[nodiscard]] static auto from_bytes(
+        std::span<std::byte const> bytes,
+        std::endian endian = std::endian::little,
+        Signedness signedness = Signedness::Unsigned
+    ) -> BigInt;
+
+    /// @brief Get the number of bytes needed to store the number in binary.
+    ///
+    /// @param signedness How the sign would be stored.
+    /// @return The smallest number of bytes that can store the number, at least 1. For Signedness::Unsigned this is the
+    /// size of the magnitude.
+    [[nodiscard]] auto byte_size(Signedness signedness = Signedness::Unsigned) const noexcept -> size_t;
+
+    /// @brief Store the binary representation of the number in a buffer.
+    ///
+    /// The whole buffer is written, the number is extended with zeroes (or with ones for negative numbers in two's
+    /// complement) if the buffer is larger than needed.
+    ///
+    /// @param bytes The buffer to write to, must be at least byte_size(signedness) bytes.
+    /// @param endian The byte order to write the bytes in.
+    /// @param signedness How the sign is stored in the bytes.
+    ///
+    /// @throws std::overflow_error if the buffer is too small.
+    /// @throws std::underflow_error if the number is negative and signedness is Signedness::Unsigned.
+    void export_to(
+        std::span<std::byte> bytes,
+        std::endian endian = std::endian::little,
+        Signedness signedness = Signedness::Unsigned
+    ) const;
+
+    /// @brief Get the binary representation of the number.
+    ///
+    /// @param endian The byte order of the bytes.
+    /// @param signedness How the sign is stored in the bytes.
+    /// @return byte_size(signedness) bytes representing the number.
+    ///
+    /// @throws std::underflow_error if the number is negative and signedness is Signedness::Unsigned.
+    [[nodiscard]] auto to_bytes(
+        std::endian endian = std::endian::little,
+        Signedness signedness = Signedness::Unsigned
+    ) const -> std::vector<std::byte>;
+
+    /// @brief Get the size of the compact encoding of the number.
+    ///
+    /// The compact encoding is an unsigned LEB128 header holding the number of magnitude bytes shifted left by one and
+    /// the sign in the lowest bit, followed by the magnitude in little endian. Numbers below 2^(7 * 8) take at most 8
+    /// bytes, and 0 takes a single byte.
+    [[nodiscard]] auto compact_size() const noexcept -> size_t;
+
+    /// @brief Append the compact encoding of numbers to a buffer.
+    ///
+    /// The buffer is grown once for all numbers and the encodings are written one after the other.
+    ///
+    /// @param values The numbers to encode.
+    /// @param[out] output The buffer to append the encodings to.
+    static void encode_compact(std::span<BigInt const> values, std::vector<std::byte> &output);
+
+    /// @brief Decode numbers stored one after the other in the compact encoding.
+    ///
+    /// @param bytes The encoded numbers.
+    /// @return The decoded numbers, in the order they are stored.
+    ///
+    /// @throws std::invalid_argument if the bytes end in the middle of a number or a header is invalid.
+    [[nodiscard]] static auto decode_compact(std::span<std::byte const> bytes) -> std::vector<BigInt>;
+
+    friend std::formatter<BigIntView>;
+    friend class BigIntView;
+    friend auto operator+(BigIntView lhs, BigIntView rhs) -> BigInt;
+    friend auto operator*(BigIntView lhs, BigIntView rhs) -> BigInt;
+    friend auto multiply(BigIntView lhs, BigIntView rhs, ExecutionPolicy const &policy) -> BigInt;
+    friend auto operator<=>(BigIntView lhs, BigIntView rhs) noexcept -> std::strong_ordering;
+    friend auto gcd(BigIntView a, BigIntView b) -> BigInt;
+    friend auto gcdext(BigIntView a, BigIntView b) -> std::tuple<BigInt, BigInt, BigInt>;
+    friend class detail::Montgomery;
+    friend class detail::LazyEvaluator;
+    template<size_t Limbs>
+    friend class Batch;
+
+private:
     /// @brief Type used to store the number.
     using DataType = std::vector<ChunkType>;
 
@@ -193,7 +400,7 @@ private:
     /// @brief Chunks of the number. Stored in little endian.
     DataType chunks;
 
-    /// @brief Supported bases.
+    /// @brief Base of a number. Any value from 2 to 36 is supported, the common ones are named.
     enum class Base : std::uint_fast8_t
     {
         Binary = 2,
@@ -202,6 +409,9 @@ private:
         Hexadecimal = 16
     };
 
+    /// @brief Number of chunks above which base conversions switch to divide-and-conquer.
+    static constexpr size_t conversion_threshold = 32;
+
     /// @brief Number of bits in a chunk.
     static constexpr auto chunk_bits = sizeof(ChunkType) * 8;
     /// @brief Maximum value a chunk can store.
@@ -216,6 +426,11 @@ private:
     ///              significant bit.
     [[nodiscard]] auto get_bit_at(size_t index) const -> bool;
 
+    /// @brief Convert a numeric base to Base.
+    ///
+    /// @throws std::invalid_argument if the base is out of range.
+    [[nodiscard]] static auto to_base(int base) -> Base;
+
     /// @brief Check if the number is zero.
     [[nodiscard]] auto is_zero() const -> bool;
     /// @brief Remove leading zero chunks from the number.
@@ -227,17 +442,28 @@ private:
     /// @return Ordering of the magnitude of the two numbers.
     [[nodiscard]] auto compare_magnitude(BigInt const &rhs) const noexcept -> std::strong_ordering;
 
-    /// @brief Add the magnitude of lhs and rhs.
+    /// @brief Compare two magnitudes.
     ///
-    /// @param rhs The number to add, must be smaller than or equal to lhs.
-    /// @return The result of the addition.
-    [[nodiscard]] auto add_magnitude(BigInt const &rhs) const noexcept -> BigInt;
+    /// @param lhs Chunks of the first number in little endian, without leading zeroes.
+    /// @param rhs Chunks of the second number in little endian, without leading zeroes.
+    /// @return Ordering of the two magnitudes.
+    [[nodiscard]] static auto compare_magnitude(std::span<ChunkType const> lhs, std::span<ChunkType const> rhs) noexcept
+        -> std::strong_ordering;
+
+    /// @brief Add two magnitudes.
+    ///
+    /// @param lhs Chunks of the first number in little endian.
+    /// @param rhs Chunks of the second number in little endian, must not have more chunks than lhs.
+    /// @return The non-negative sum.
+    [[nodiscard]] static auto add_magnitude(std::span<ChunkType const> lhs, std::span<ChunkType const> rhs) -> BigInt;
 
     /// @brief Subtract the magnitude of rhs from lhs.
     ///
-    /// @param rhs The number to subtract, must be smaller than or equal to lhs.
-    /// @return The result of the subtraction.
-    [[nodiscard]] auto subtract_magnitude(BigInt const &rhs) const noexcept -> BigInt;
+    /// @param lhs Chunks of the first number in little endian.
+    /// @param rhs Chunks of the number to subtract in little endian, must be smaller than or equal to lhs.
+    /// @return The non-negative difference.
+    [[nodiscard]] static auto subtract_magnitude(std::span<ChunkType const> lhs, std::span<ChunkType const> rhs)
+        -> BigInt;
 
     /// @brief Multiply two chunks and return the result as two chunks.
     ///
@@ -248,13 +474,88 @@ private:
     /// second chunk contains the overflow.
     [[nodiscard]] static auto multiply_chunks(ChunkType a, ChunkType b) noexcept -> std::pair<ChunkType, ChunkType>;
 
+    /// @brief Divide a two chunk number by a single chunk.
+    ///
+    /// @param high The most significant chunk of the dividend, must be smaller than the divisor.
+    /// @param low The least significant chunk of the dividend.
+    /// @param divisor The divisor, must not be 0.
+    /// @return The quotient and the remainder.
+    [[nodiscard]] static auto divide_chunks(ChunkType high, ChunkType low, ChunkType divisor) noexcept
+        -> std::pair<ChunkType, ChunkType>;
+
+    /// @brief Multiply two magnitudes using schoolbook multiplication.
+    ///
+    /// @param lhs Chunks of the first number in little endian.
+    /// @param rhs Chunks of the second number in little endian.
+    /// @param[out] result Chunks of the product, must be exactly lhs.size() + rhs.size() chunks long.
+    static void multiply_schoolbook(
+        std::span<ChunkType const> lhs,
+        std::span<ChunkType const> rhs,
+        std::span<ChunkType> result
+    ) noexcept;
+
+    /// @brief Multiply two magnitudes, using Karatsuba's algorithm for large ones.
+    ///
+    /// Operands of similar size are split in halves and multiplied with three half size products instead of four. A
+    /// much longer operand is cut into blocks of the size of the shorter one. The three products are independent, so a
+    /// parallel policy runs them on different threads.
+    ///
+    /// @param lhs Chunks of the first number in little endian.
+    /// @param rhs Chunks of the second number in little endian.
+    /// @param[out] result Chunks of the product, must be exactly lhs.size() + rhs.size() chunks long.
+    /// @param policy Whether the products of large operands run in parallel.
+    static void multiply_magnitude(
+        std::span<ChunkType const> lhs,
+        std::span<ChunkType const> rhs,
+        std::span<ChunkType> result,
+        ExecutionPolicy const &policy = ExecutionPolicy::serial()
+    );
+
+    /// @brief Divide two magnitudes using long division (Knuth's Algorithm D).
+    ///
+    /// @param num Chunks of the dividend in little endian.
+    /// @param denom Chunks of the divisor in little endian, the most significant chunk must not be 0.
+    /// @param[out] quotient Chunks of the quotient, leading zeroes are removed.
+    /// @param[out] remainder Chunks of the remainder, leading zeroes are removed.
+    static void divide_magnitude(
+        std::span<ChunkType const> num,
+        std::span<ChunkType const> denom,
+        DataType &quotient,
+        DataType &remainder
+    );
+
+    /// @brief Get the greatest common divisor of two chunks using binary GCD.
+    [[nodiscard]] static auto binary_gcd(ChunkType a, ChunkType b) noexcept -> ChunkType;
+
+    /// @brief Run Euclid's algorithm on two magnitudes until the smaller one fits in a single chunk.
+    ///
+    /// Lehmer's algorithm is used: Euclid's algorithm runs on the leading bits of both numbers to find a matrix that
+    /// performs several steps at once with single chunk multiplications. A full division step is done when the leading
+    /// bits don't determine a quotient, which happens when the numbers have very different sizes. The matrix is applied
+    /// to both numbers in a single pass over their chunks, into buffers reused by every step.
+    ///
+    /// Half-GCD, which reduces the cost from O(n^2) to O(M(n) log n), isn't implemented. Its recursion and its
+    /// matrix products only win over Lehmer above a crossover of several hundred chunks even with Karatsuba
+    /// multiplication, well above the operands of modular inversion, the main user of gcdext().
+    ///
+    /// @param[in,out] u The larger magnitude.
+    /// @param[in,out] v The smaller magnitude.
+    /// @param[in,out] cofactors If not null, two numbers updated with the same steps as u and v, which are the
+    ///                          cofactors of one of the original numbers when they start as 1 and 0.
+    static void lehmer_reduce(BigInt &u, BigInt &v, std::pair<BigInt, BigInt> *cofactors);
+
+    /// @brief Divide a magnitude by a single chunk in place.
+    ///
+    /// @param[in,out] num Chunks of the dividend in little endian, replaced by the quotient. Leading zeroes are kept.
+    /// @param divisor The divisor, must not be 0.
+    /// @return The remainder.
+    static auto divide_by_chunk(std::span<ChunkType> num, ChunkType divisor) noexcept -> ChunkType;
+
     /// @brief Check if character is a valid digit in the given base.
     ///
     /// @param base The base to check the digit in.
     /// @param c The character to check.
     /// @return True if the character is a valid digit in the given base, false otherwise.
-    ///
-    /// @note Only works for bases 2, 8, 10, and 16.
     [[nodiscard]] static auto is_valid_digit(Base base, char c) -> bool;
 
     /// @brief Convert character to digit in the given base. The character must be a valid digit in the given base.
@@ -264,36 +565,43 @@ private:
     /// @return The digit represented by the character.
     ///
     /// @throws std::invalid_argument if the character is not a valid digit in the given base.
-    /// @note Only works for bases 2, 8, 10, and 16.
     [[nodiscard]] static auto char_to_digit(Base base, char c) -> ChunkType;
 
-    /// @brief Long divide string representation of a number by a divisor.
-    ///
-    /// @param num The number to divide, must be unsigned.
-    /// @param[out] quotient Resulting quotient.
-    /// @param base The base of the number.
-    /// @param divisor The divisor.
-    /// @return The remainder.
-    ///
-    /// @throws std::invalid_argument if num contains invalid digits for the given base.
-    /// @note Only works for bases 2, 8, 10, and 16.
-    static auto long_divide(std::string_view num, std::string &quotient, Base base, ChunkType divisor) -> ChunkType;
-
     /// @brief Convert string with power of two base to binary and store it in chunks.
     ///
     /// @param num The number to convert, must be unsigned.
     /// @param base The base of the number.
     ///
     /// @throws std::invalid_argument if num contains invalid digits for the given base.
-    /// @note Only works for bases 2, 8, and 16.
+    /// @note Only works for bases that are a power of two.
     void power_of_two_base_to_binary(std::string_view num, Base base);
 
-    /// @brief Convert decimal base to binary and store it in chunks.
+    /// @brief Multiply the magnitude by a chunk and add another chunk to it, in place.
+    ///
+    /// @param multiplier The chunk to multiply by.
+    /// @param addend The chunk to add after the multiplication.
+    void multiply_add(ChunkType multiplier, ChunkType addend);
+
+    /// @brief Convert a base that is not a power of two to binary and store it in chunks.
+    ///
+    /// Groups of digits that fit in a chunk are combined with multiply_add for small numbers. Large numbers are split
+    /// in halves at powers of the base which are converted separately and combined with a single multiplication.
     ///
     /// @param num The number to convert, must be unsigned.
+    /// @param base The base of the number.
     ///
     /// @throws std::invalid_argument if num contains invalid digits for the given base.
-    void decimal_base_to_binary(std::string_view num);
+    void big_base_to_binary(std::string_view num, Base base);
+
+    /// @brief Get the number of digits of a base that fit in a chunk.
+    [[nodiscard]] static auto digits_per_chunk(Base base) noexcept -> size_t;
+
+    /// @brief Get the powers big_base^(2^i) of the largest power of a base that fits in a chunk.
+    ///
+    /// @param base The base to get the powers of.
+    /// @param count The number of powers to get.
+    /// @return The powers from the shared cache of powers, in increasing order.
+    [[nodiscard]] static auto big_base_powers(Base base, size_t count) -> std::vector<SharedBigInt>;
 
     /// @brief Convert a base to binary and store it in chunks.
     ///
@@ -301,92 +609,595 @@ private:
     /// @param base The base of the number.
     ///
     /// @throws std::invalid_argument if num contains invalid digits for the given base.
-    /// @note Only works for bases 2, 8, 10, and 16.
     void base_to_binary(std::string_view num, Base base);
 
-    /// @brief Format the number to a power of two base.
+    /// @brief Get the prefix used for the given base (e.g. 0b for binary).
     ///
-    /// @param base The base to format the number to.
-    /// @param add_prefix Whether to add a base prefix to the formatted number (e.g. 0b for binary).
-    /// @param capitalize Whether to capitalize the base prefix (if any) and the digits (for hexadecimal).
-    /// @return The formatted number.
+    /// @param num The number to prefix.
+    /// @param base The base to get the prefix of.
+    /// @param capitalize Whether to capitalize the prefix.
+    /// @return The prefix, which is empty for decimal and for zero in octal.
+    [[nodiscard]] static auto base_prefix(BigIntView num, Base base, bool capitalize) noexcept -> std::string_view;
+
+    /// @brief Callback that receives consecutive blocks of formatted digits, most significant digit first.
+    using DigitSink = std::function<void(std::string_view)>;
+
+    /// @brief Get the number of digits needed to represent the magnitude of a number in the given base.
     ///
-    /// @note Only works for bases 2, 8, and 16.
-    [[nodiscard]] auto
-    format_to_power_of_two_base(Base base, bool add_prefix = false, bool capitalize = false) const noexcept
-        -> std::string;
+    /// @param num The number to count the digits of.
+    /// @param base The base to count the digits in.
+    /// @return The number of digits, not including any sign or base prefix. Zero has one digit.
+    [[nodiscard]] static auto digit_count(BigIntView num, Base base) -> size_t;
 
-    /// @brief Format the number to decimal.
+    /// @brief Write the digits of the magnitude of a number to a sink without building an intermediate string.
     ///
-    /// @return The formatted number.
-    [[nodiscard]] auto format_to_decimal() const -> std::string;
+    /// The magnitude is only read, numbers of up to conversion_threshold chunks are converted without allocating.
+    ///
+    /// @param num The number to write.
+    /// @param base The base to write the digits in.
+    /// @param capitalize Whether to capitalize the digits (for bases above 10).
+    /// @param sink Callback that receives the digits in blocks, most significant digit first.
+    static void write_digits(BigIntView num, Base base, bool capitalize, DigitSink const &sink);
 
-    /// @brief Format the number to the specified base.
+    /// @brief Format a number to the specified base.
     ///
+    /// @param num The number to format.
     /// @param base The base to format the number to.
     /// @param add_prefix Whether to add a base prefix to the formatted number (e.g. 0b for binary).
-    /// @param capitalize Whether to capitalize the base prefix (if any) and the digits (for hexadecimal).
+    /// @param capitalize Whether to capitalize the base prefix (if any) and the digits (for bases above 10).
     /// @return The formatted number.
+    [[nodiscard]] static auto format_to_base(
+        BigIntView num,
+        Base base,
+        bool add_prefix = false,
+        bool capitalize = false
+    ) -> std::string;
+};
+}  // namespace BI
+
+namespace BI
+{
+/// @brief Read-only view of a number stored elsewhere, such as a BigInt or an external buffer of chunks.
+///
+/// A view only holds a sign and a span of chunks, so it's cheap to copy and never allocates. Arithmetic on views uses
+/// the same kernels as BigInt and only allocates for the result. The viewed chunks must outlive the view.
+class BigIntView
+{
+public:
+    using ChunkType = BigInt::ChunkType;
+
+    /// @brief Construct a view of 0.
+    constexpr BigIntView() noexcept = default;
+
+    /// @brief Construct a view of a BigInt. The view is invalidated when the BigInt is modified or destroyed.
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    BigIntView(BigInt const &num) noexcept;
+
+    /// @brief Construct a view of a buffer of chunks.
     ///
-    /// @note Only works for bases 2, 8, 10, and 16.
-    [[nodiscard]] auto format_to_base(Base base, bool add_prefix = false, bool capitalize = false) const -> std::string;
+    /// @param num_chunks Chunks of the magnitude in little endian. Leading zero chunks are ignored and an empty span is
+    ///                   0.
+    /// @param num_negative Whether the number is negative. Ignored for 0.
+    constexpr explicit BigIntView(std::span<ChunkType const> num_chunks, bool num_negative = false) noexcept
+        : magnitude{num_chunks}
+    {
+        while (!magnitude.empty() && magnitude.back() == 0)
+        {
+            magnitude = magnitude.first(magnitude.size() - 1);
+        }
+
+        negative = num_negative && !magnitude.empty();
+    }
+
+    /// @brief Get the chunks of the magnitude in little endian, without leading zeroes. Empty for 0.
+    [[nodiscard]] constexpr auto chunks() const noexcept -> std::span<ChunkType const>
+    {
+        return magnitude;
+    }
+
+    /// @brief Check if the number is negative.
+    [[nodiscard]] constexpr auto is_negative() const noexcept -> bool
+    {
+        return negative;
+    }
+
+    /// @brief Check if the number is zero.
+    [[nodiscard]] constexpr auto is_zero() const noexcept -> bool
+    {
+        return magnitude.empty();
+    }
+
+    /// @brief Get a view of the absolute value of the number.
+    [[nodiscard]] constexpr auto abs() const noexcept -> BigIntView
+    {
+        return BigIntView(magnitude);
+    }
+
+    /// @brief Convert the number to a string in the given base.
+    ///
+    /// @param base The base to convert to, from 2 to 36.
+    /// @param capitalize Whether to use uppercase letters for digits above 9.
+    /// @return The digits of the number, preceded by a minus sign if it's negative.
+    ///
+    /// @throws std::invalid_argument if the base is out of range.
+    [[nodiscard]] auto to_string(int base = 10, bool capitalize = false) const -> std::string;
+
+    constexpr auto operator-() const noexcept -> BigIntView
+    {
+        return BigIntView(magnitude, !negative);
+    }
+
+    friend auto operator+(BigIntView lhs, BigIntView rhs) -> BigInt;
+    friend auto operator-(BigIntView lhs, BigIntView rhs) -> BigInt;
+    friend auto operator*(BigIntView lhs, BigIntView rhs) -> BigInt;
+    friend auto multiply(BigIntView lhs, BigIntView rhs, ExecutionPolicy const &policy) -> BigInt;
+    friend auto operator/(BigIntView lhs, BigIntView rhs) -> BigInt;
+    friend auto operator%(BigIntView lhs, BigIntView rhs) -> BigInt;
+
+    friend auto operator<=>(BigIntView lhs, BigIntView rhs) noexcept -> std::strong_ordering;
+    friend auto operator==(BigIntView lhs, BigIntView rhs) noexcept -> bool;
+
+private:
+    /// @brief Chunks of the magnitude in little endian, without leading zeroes.
+    std::span<ChunkType const> magnitude;
+    /// @brief Sign of the number, never set for 0.
+    bool negative{false};
 };
+
+/// @brief Multiply two numbers with an explicit execution policy.
+///
+/// The operators use the default policy, see set_default_execution_policy().
+///
+/// @param lhs The first number.
+/// @param rhs The second number.
+/// @param policy Whether large products are computed in parallel.
+/// @return The product.
+[[nodiscard]] auto multiply(BigIntView lhs, BigIntView rhs, ExecutionPolicy const &policy) -> BigInt;
+
+/// @brief Multiply many numbers.
+///
+/// The numbers are multiplied in a balanced tree. Every level pairs operands of about the same size and its products
+/// are spread over the threads of the policy, the last levels use parallel multiplications instead.
+///
+/// @param values The numbers to multiply.
+/// @param policy Whether the products are computed in parallel.
+/// @return The product, 1 if there are no numbers.
+[[nodiscard]] auto reduce_product(
+    std::span<BigInt const> values,
+    ExecutionPolicy const &policy = get_default_execution_policy()
+) -> BigInt;
+
+/// @brief Add many numbers.
+///
+/// Every thread of the policy sums a block of the numbers chunk by chunk and only counts the carries, which are
+/// propagated once at the end.
+///
+/// @param values The numbers to add.
+/// @param policy Whether the numbers are added in parallel.
+/// @return The sum, 0 if there are no numbers.
+[[nodiscard]] auto reduce_sum(
+    std::span<BigInt const> values,
+    ExecutionPolicy const &policy = get_default_execution_policy()
+) -> BigInt;
+
+/// @brief Get the greatest common divisor of two numbers.
+///
+/// Lehmer's algorithm reduces the numbers until they fit in a single chunk, binary GCD does the rest.
+///
+/// @return The non-negative greatest common divisor, 0 if both numbers are 0.
+[[nodiscard]] auto gcd(BigIntView a, BigIntView b) -> BigInt;
+
+/// @brief Get the least common multiple of two numbers.
+///
+/// @return The non-negative least common multiple, 0 if either number is 0.
+[[nodiscard]] auto lcm(BigIntView a, BigIntView b) -> BigInt;
+
+/// @brief Get the greatest common divisor of two numbers and the Bezout coefficients.
+///
+/// @return The greatest common divisor g and the coefficients s and t such that a * s + b * t = g. g is non-negative,
+/// and the coefficients are the ones found by Euclid's algorithm, so |s| <= |b| / g and |t| <= |a| / g.
+[[nodiscard]] auto gcdext(BigIntView a, BigIntView b) -> std::tuple<BigInt, BigInt, BigInt>;
+
+/// @brief Get the inverse of a number modulo another number.
+///
+/// @param a The number to invert, may be negative.
+/// @param modulus The modulus, only its magnitude is used.
+/// @return The x in [0, |modulus|) such that a * x = 1 mod |modulus|.
+///
+/// @throws std::domain_error if the modulus is 0 or a is not coprime with it.
+[[nodiscard]] auto invert(BigIntView a, BigIntView modulus) -> BigInt;
+
+/// @brief Invert many numbers modulo the same modulus in place.
+///
+/// Montgomery's trick replaces the inversions by a single one and 3(n - 1) modular multiplications, which use
+/// Montgomery multiplication when the modulus is odd.
+///
+/// @param values The numbers to invert, replaced by their inverses in [0, |modulus|).
+/// @param modulus The modulus, only its magnitude is used.
+///
+/// @throws std::domain_error if the modulus is 0 or a number is not coprime with it. The numbers are left unchanged.
+void batch_invert(std::span<BigInt> values, BigIntView modulus);
+
+/// @brief Raise a number to a power modulo another number.
+///
+/// Odd moduli use Montgomery multiplication, even moduli fall back to reduction by division. The exponent is processed
+/// with a sliding window whose size grows with the exponent.
+///
+/// @param base The number to raise, may be negative.
+/// @param exponent The power, must not be negative.
+/// @param modulus The modulus, only its magnitude is used.
+/// @return base^exponent mod |modulus|, in [0, |modulus|).
+///
+/// @throws std::domain_error if the modulus is 0 or the exponent is negative.
+[[nodiscard]] auto powm(BigIntView base, BigIntView exponent, BigIntView modulus) -> BigInt;
+
+/// @brief Raise a number to a secret power modulo an odd number.
+///
+/// Unlike powm(), the sequence of operations and memory accesses only depends on the number of chunks of the exponent
+/// and the modulus, not on their values, so the exponent can't be recovered from timing or cache side channels.
+///
+/// @param base The number to raise, may be negative.
+/// @param exponent The power, must not be negative.
+/// @param modulus The modulus, must be odd. Only its magnitude is used.
+/// @return base^exponent mod |modulus|, in [0, |modulus|).
+///
+/// @throws std::domain_error if the modulus is even or the exponent is negative.
+[[nodiscard]] auto powm_sec(BigIntView base, BigIntView exponent, BigIntView modulus) -> BigInt;
+
+/// @brief Get the square root of a number rounded down.
+///
+/// Newton's method refines a root of the leading half of the bits, which is found the same way down to a root that
+/// fits in a double, so only the last iterations run at full precision.
+///
+/// @throws std::domain_error if the number is negative.
+[[nodiscard]] auto isqrt(BigIntView num) -> BigInt;
+
+/// @brief Get the square root of a number rounded down and the remainder.
+///
+/// @return The root s and the remainder num - s^2.
+///
+/// @throws std::domain_error if the number is negative.
+[[nodiscard]] auto sqrtrem(BigIntView num) -> std::pair<BigInt, BigInt>;
+
+/// @brief Get the k-th root of a number rounded towards 0.
+///
+/// @param num The number, may only be negative if k is odd.
+/// @param k The degree of the root.
+///
+/// @throws std::domain_error if k is 0, or if num is negative and k is even.
+[[nodiscard]] auto root(BigIntView num, size_t k) -> BigInt;
+
+/// @brief Check if a number is the square of an integer.
+///
+/// Residues modulo 64, 63, 65 and 11 reject most numbers before the square root is computed.
+[[nodiscard]] auto is_perfect_square(BigIntView num) -> bool;
+
+/// @brief Check if a number is a^k for an integer a and some k >= 2. 0, 1 and -1 are perfect powers.
+///
+/// Only prime degrees that divide the exponent of 2 in the number are tried, and residues modulo small primes reject
+/// most of them before the root is computed.
+[[nodiscard]] auto is_perfect_power(BigIntView num) -> bool;
+
+/// @brief Check if a number is probably prime.
+///
+/// Candidates are first divided by the small primes, all at once from a single pass over the chunks. The survivors go
+/// through the Baillie-PSW test (a Miller-Rabin test to base 2 and a strong Lucas test), which has no known
+/// counterexample, then through Miller-Rabin tests to random bases.
+///
+/// @param num The number to test, numbers smaller than 2 are not prime.
+/// @param rounds Number of additional Miller-Rabin tests, each one lets through at most 1/4 of the composite numbers.
+/// @return false if the number is composite, true if it is prime or a pseudoprime to every test.
+[[nodiscard]] auto is_probable_prime(BigIntView num, size_t rounds = 0) -> bool;
+
+/// @brief Get the smallest probable prime larger than a number.
+///
+/// Windows of candidates are sieved with the small primes, and only the remaining ones are tested with Baillie-PSW.
+[[nodiscard]] auto next_prime(BigIntView num) -> BigInt;
+
+/// @brief Get the product of the integers in [first, last), 1 if the range is empty.
+///
+/// The range is split in halves recursively, so the operands of every multiplication have about the same size.
+[[nodiscard]] auto product(std::uint64_t first, std::uint64_t last) -> BigInt;
+
+/// @brief Get n!.
+///
+/// Uses the prime swing algorithm, n! = (floor(n / 2)!)^2 * swing(n), where the swinging factorial is multiplied from
+/// its prime factorization with a product tree.
+[[nodiscard]] auto factorial(std::uint64_t n) -> BigInt;
+
+/// @brief Get the binomial coefficient C(n, k), 0 if k > n.
+///
+/// When k is a sizable fraction of n, the coefficient is multiplied from its prime factorization, given by Kummer's
+/// theorem, with a product tree. Otherwise it's the product of the k largest factors of n! divided by k!.
+[[nodiscard]] auto binomial(std::uint64_t n, std::uint64_t k) -> BigInt;
+
+/// @brief Get the product of the primes up to n.
+[[nodiscard]] auto primorial(std::uint64_t n) -> BigInt;
 }  // namespace BI
 
 auto operator<<(std::ostream &os, BI::BigInt const &num) -> std::ostream &;
-auto operator""_bi(char const *) -> BI::BigInt;
+auto operator>>(std::istream &is, BI::BigInt &num) -> std::istream &;
+namespace BI::detail
+{
+/// @brief Get the chunks of an integer literal, little endian with leading zeroes.
+///
+/// Accepts the same prefixes as the C++ integer literals (0x, 0b and 0 for octal) and skips digit separators.
+/// Digits are accumulated in 32-bit pieces so no wider type than 64 bits is needed.
+///
+/// @throws std::invalid_argument if the literal isn't an integer, which fails the compilation.
+template<char... Digits>
+consteval auto literal_chunks()
+{
+    using ChunkType = BigInt::ChunkType;
+
+    constexpr std::array<char, sizeof...(Digits)> literal{Digits...};
+    constexpr size_t piece_bits = 32;
+    constexpr size_t pieces_per_chunk = sizeof(ChunkType) * 8 / piece_bits;
+    // Every digit adds at most 4 bits, even in decimal.
+    constexpr size_t piece_count = ((literal.size() * 4) / piece_bits) + 1;
+    constexpr size_t chunk_count = (piece_count + pieces_per_chunk - 1) / pieces_per_chunk;
+
+    size_t index = 0;
+    std::uint32_t base = 10;
+
+    if (literal.size() > 1 && literal[0] == '0')
+    {
+        char const prefix = literal[1];
+        base = prefix == 'x' || prefix == 'X' ? 16 : prefix == 'b' || prefix == 'B' ? 2 : 8;
+        index = base == 8 ? 1 : 2;
+    }
+
+    std::array<std::uint32_t, piece_count> pieces{};
+
+    for (; index < literal.size(); ++index)
+    {
+        char const c = literal[index];
+        std::uint32_t digit = 0;
+
+        if (c == '\'')
+        {
+            continue;
+        }
+        if (c >= '0' && c <= '9')
+        {
+            digit = static_cast<std::uint32_t>(c - '0');
+        }
+        else if (c >= 'a' && c <= 'f')
+        {
+            digit = static_cast<std::uint32_t>(c - 'a' + 10);
+        }
+        else if (c >= 'A' && c <= 'F')
+        {
+            digit = static_cast<std::uint32_t>(c - 'A' + 10);
+        }
+        else
+        {
+            throw std::invalid_argument("BigInt literals must be integers");
+        }
+
+        if (digit >= base)
+        {
+            throw std::invalid_argument("Invalid digit in BigInt literal");
+        }
+
+        // pieces = pieces * base + digit.
+        std::uint64_t carry = digit;
+
+        for (std::uint32_t &piece : pieces)
+        {
+            std::uint64_t const value = (static_cast<std::uint64_t>(piece) * base) + carry;
+            piece = static_cast<std::uint32_t>(value);
+            carry = value >> piece_bits;
+        }
+    }
+
+    std::array<ChunkType, chunk_count> chunks{};
+
+    for (size_t i = 0; i < pieces.size(); ++i)
+    {
+        chunks[i / pieces_per_chunk] |= static_cast<ChunkType>(pieces[i]) << (piece_bits * (i % pieces_per_chunk));
+    }
+
+    return chunks;
+}
+}  // namespace BI::detail
+
+/// @brief Literal for BigInt constants, e.g. 123_bi or 0xFF_bi.
+///
+/// The digits are converted to chunks at compile time, at runtime the literal only copies them.
+template<char... Digits>
+auto operator""_bi() -> BI::BigInt
+{
+    static constexpr auto chunks = BI::detail::literal_chunks<Digits...>();
+    return BI::BigInt(BI::BigIntView(chunks));
+}
 
+/// @brief Formatter for BigIntView.
+///
+/// Supports the standard integer format specification: `[[fill]align][sign][#][0][width][L][type]`, where the
+/// width can also be a nested replacement field. Digits are written directly to the output in blocks.
 template<>
-struct std::formatter<BI::BigInt> : std::formatter<std::string>
+struct std::formatter<BI::BigIntView>
 {
     using BigInt = BI::BigInt;
 
+    /// @brief Alignment of the number within the field width.
+    enum class Align : std::uint_fast8_t
+    {
+        Default,
+        Left,
+        Center,
+        Right
+    };
+
+    /// @brief How the sign is written for non-negative numbers.
+    enum class Sign : std::uint_fast8_t
+    {
+        Minus,
+        Plus,
+        Space
+    };
+
+    /// @brief Fill character, stored as a UTF-8 code unit sequence.
+    std::array<char, 4> fill{' '};
+    size_t fill_size = 1;
+    Align align{Align::Default};
+    Sign sign{Sign::Minus};
     bool add_prefix = false;
+    bool zero_pad = false;
+    bool use_locale = false;
     bool capitalize = false;
+    size_t width = 0;
+    /// @brief Argument index of the width if it is given as a nested replacement field.
+    std::optional<size_t> width_arg_id;
     BigInt::Base base{BigInt::Base::Decimal};
 
     constexpr auto parse(std::format_parse_context &ctx) -> decltype(ctx.begin())
     {
         auto const *it = ctx.begin();
+        auto const *const end = ctx.end();
+
+        auto to_align = [](char c) -> std::optional<Align>
+        {
+            switch (c)
+            {
+            case '<':
+                return Align::Left;
+            case '^':
+                return Align::Center;
+            case '>':
+                return Align::Right;
+            default:
+                return std::nullopt;
+            }
+        };
 
-        if (it == ctx.end() || *it == '}')
+        auto parse_number = [&it, end]() -> size_t
+        {
+            size_t result = 0;
+            while (it != end && *it >= '0' && *it <= '9')
+            {
+                result = (result * 10) + static_cast<size_t>(*it - '0');
+                std::advance(it, 1);
+            }
+            return result;
+        };
+
+        if (it == end || *it == '}')
         {
             return it;
         }
 
-        if (*it == '#')
+        // Fill and alignment. The fill character may be any UTF-8 code point other than '{' and '}'.
+        auto const lead = static_cast<unsigned char>(*it);
+        auto const fill_length = static_cast<size_t>(lead < 0x80 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4);
+
+        if (static_cast<size_t>(end - it) > fill_length && to_align(it[fill_length]).has_value())
+        {
+            if (*it == '{' || *it == '}')
+            {
+                throw std::format_error("Invalid fill character");
+            }
+
+            std::copy_n(it, fill_length, fill.begin());
+            fill_size = fill_length;
+            align = *to_align(it[fill_length]);
+            std::advance(it, fill_length + 1);
+        }
+        else if (auto const alignment = to_align(*it))
+        {
+            align = *alignment;
+            std::advance(it, 1);
+        }
+
+        // Sign.
+        if (it != end && (*it == '+' || *it == '-' || *it == ' '))
+        {
+            sign = *it == '+' ? Sign::Plus : *it == ' ' ? Sign::Space : Sign::Minus;
+            std::advance(it, 1);
+        }
+
+        if (it != end && *it == '#')
         {
             add_prefix = true;
             std::advance(it, 1);
         }
 
-        switch (*it)
-        {
-        case 'B':
-            capitalize = true;
-            [[fallthrough]];
-        case 'b':
-            base = BigInt::Base::Binary;
-            break;
-        case 'o':
-            base = BigInt::Base::Octal;
-            break;
-        case 'd':
-            base = BigInt::Base::Decimal;
-            break;
-        case 'X':
-            capitalize = true;
-            [[fallthrough]];
-        case 'x':
-            base = BigInt::Base::Hexadecimal;
-            break;
-        default:
-            throw std::format_error("Invalid format specifier");
+        if (it != end && *it == '0')
+        {
+            zero_pad = true;
+            std::advance(it, 1);
         }
 
-        std::advance(it, 1);
+        // Width, either a number or a nested replacement field.
+        if (it != end && *it == '{')
+        {
+            std::advance(it, 1);
+
+            if (it != end && *it == '}')
+            {
+                width_arg_id = ctx.next_arg_id();
+            }
+            else
+            {
+                size_t const id = parse_number();
+                ctx.check_arg_id(id);
+                width_arg_id = id;
+            }
 
-        if (it != ctx.end() && *it != '}')
+            if (it == end || *it != '}')
+            {
+                throw std::format_error("Invalid width argument");
+            }
+
+            std::advance(it, 1);
+        }
+        else
+        {
+            width = parse_number();
+        }
+
+        if (it != end && *it == '.')
+        {
+            throw std::format_error("Precision is not allowed for integers");
+        }
+
+        if (it != end && *it == 'L')
+        {
+            use_locale = true;
+            std::advance(it, 1);
+        }
+
+        if (it != end && *it != '}')
+        {
+            switch (*it)
+            {
+            case 'B':
+                capitalize = true;
+                [[fallthrough]];
+            case 'b':
+                base = BigInt::Base::Binary;
+                break;
+            case 'o':
+                base = BigInt::Base::Octal;
+                break;
+            case 'd':
+                base = BigInt::Base::Decimal;
+                break;
+            case 'X':
+                capitalize = true;
+                [[fallthrough]];
+            case 'x':
+                base = BigInt::Base::Hexadecimal;
+                break;
+            default:
+                throw std::format_error("Invalid format specifier");
+            }
+
+            std::advance(it, 1);
+        }
+
+        if (it != end && *it != '}')
         {
             throw std::format_error("Invalid format specifier");
         }
@@ -394,8 +1205,32 @@ struct std::formatter<BI::BigInt> : std::formatter<std::string>
         return it;
     }
 
-    auto format(BigInt const &num, std::format_context &ctx) const
+    auto format(BI::BigIntView num, std::format_context &ctx) const -> std::format_context::iterator;
+};
+
+/// @brief Formatter for BigInt, which formats a view of the number.
+template<>
+struct std::formatter<BI::BigInt> : std::formatter<BI::BigIntView>
+{
+    auto format(BigInt const &num, std::format_context &ctx) const -> std::format_context::iterator
+    {
+        return std::formatter<BI::BigIntView>::format(num, ctx);
+    }
+};
+
+/// @brief Hash of a BigIntView. Equal numbers have equal hashes regardless of where they are stored.
+template<>
+struct std::hash<BI::BigIntView>
+{
+    auto operator()(BI::BigIntView num) const noexcept -> size_t;
+};
+
+/// @brief Hash of a BigInt, equal to the hash of a view of it.
+template<>
+struct std::hash<BI::BigInt>
+{
+    auto operator()(BI::BigInt const &num) const noexcept -> size_t
     {
-        return std::format_to(ctx.out(), "{}", num.format_to_base(base, add_prefix, capitalize));
+        return std::hash<BI::BigIntView>{}(num);
     }
 };
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+
+namespace BI
+{
+/// @brief How large operations may spread their work across threads.
+///
+/// Parallel work runs on a shared work-stealing pool limited to the policy's thread count, the thread that starts an
+/// operation works too.
+struct ExecutionPolicy
+{
+    /// @brief Default for parallel_threshold, below it the cost of handing work to other threads isn't worth it.
+    static constexpr size_t default_parallel_threshold = 512;
+
+    /// @brief Number of threads, 0 for one per hardware thread and 1 to run serially.
+    size_t threads{1};
+    /// @brief Operands with fewer chunks than this are always processed serially.
+    size_t parallel_threshold{default_parallel_threshold};
+
+    /// @brief Get a policy that runs everything on the calling thread.
+    [[nodiscard]] static constexpr auto serial() noexcept -> ExecutionPolicy
+    {
+        return ExecutionPolicy{};
+    }
+
+    /// @brief Get a policy that uses multiple threads for large operands.
+    ///
+    /// @param threads Number of threads, 0 for one per hardware thread.
+    [[nodiscard]] static constexpr auto parallel(size_t threads = 0) noexcept -> ExecutionPolicy
+    {
+        return ExecutionPolicy{.threads = threads};
+    }
+
+    /// @brief Check if operands with the given number of chunks are processed in parallel.
+    [[nodiscard]] constexpr auto is_parallel(size_t chunks) const noexcept -> bool
+    {
+        return threads != 1 && chunks >= parallel_threshold;
+    }
+};
+
+/// @brief Get the policy used by the operators, serial unless it was changed.
+[[nodiscard]] auto get_default_execution_policy() noexcept -> ExecutionPolicy;
+
+/// @brief Set the policy used by the operators for every thread.
+void set_default_execution_policy(ExecutionPolicy policy) noexcept;
+}  // namespace BI
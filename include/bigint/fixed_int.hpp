@@ -0,0 +1,592 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <limits>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "bigint.hpp"
+
+namespace BI
+{
+/// @brief Integer of a fixed number of bits stored inline, with constexpr arithmetic.
+///
+/// Arithmetic wraps around modulo 2^Bits like the built-in unsigned types, signed numbers are stored in two's
+/// complement. Nothing is allocated, so every operation except the conversions from and to BigInt and strings can run
+/// at compile time. The limb loops of narrow numbers are unrolled.
+///
+/// @tparam Bits Number of bits.
+/// @tparam Signed Whether the numbers are signed, the most significant bit is then the sign.
+template<size_t Bits, bool Signed = false>
+class FixedInt
+{
+public:
+    static_assert(Bits > 0, "FixedInt must have at least one bit");
+
+    using ChunkType = BigInt::ChunkType;
+
+    static constexpr size_t chunk_bits = sizeof(ChunkType) * 8;
+    /// @brief Number of chunks of the storage.
+    static constexpr size_t limb_count = (Bits + chunk_bits - 1) / chunk_bits;
+
+    /// @brief Chunks of the number in little endian, the bits above Bits are always 0.
+    using Limbs = std::array<ChunkType, limb_count>;
+
+    /// @brief Construct 0.
+    constexpr FixedInt() noexcept = default;
+
+    /// @brief Construct a number from a built-in integer, wrapping around if it doesn't fit.
+    template<std::integral T>
+    constexpr explicit FixedInt(T value) noexcept
+    {
+        // Sign-extend to the widest type first, the limbs above it are copies of the sign.
+        std::uintmax_t const wide = std::is_signed_v<T> ? static_cast<std::uintmax_t>(static_cast<std::intmax_t>(value))
+                                                        : static_cast<std::uintmax_t>(value);
+        ChunkType const fill = std::is_signed_v<T> && value < 0 ? chunk_max : 0;
+        constexpr size_t wide_bits = sizeof(std::uintmax_t) * 8;
+
+        for (size_t i = 0; i < limb_count; ++i)
+        {
+            limbs[i] = i * chunk_bits < wide_bits ? static_cast<ChunkType>(wide >> (i * chunk_bits)) : fill;
+        }
+
+        mask();
+    }
+
+    /// @brief Convert a BigInt.
+    ///
+    /// @throws std::overflow_error if the number is out of range.
+    explicit FixedInt(BigIntView value)
+    {
+        std::span<ChunkType const> const chunks = value.chunks();
+        size_t const bits = chunks.empty()
+                                ? 0
+                                : (chunks.size() * chunk_bits) - static_cast<size_t>(std::countl_zero(chunks.back()));
+
+        // Signed numbers go down to -2^(Bits - 1), whose magnitude is the only one with Bits bits.
+        bool const fits = Signed ? (bits < Bits || (value.is_negative() && bits == Bits && is_power_of_two(chunks)))
+                                 : (!value.is_negative() && bits <= Bits);
+
+        if (!fits)
+        {
+            throw std::overflow_error(
+                std::format("Number doesn't fit in {} {} bits", Bits, Signed ? "signed" : "unsigned")
+            );
+        }
+
+        for (size_t i = 0; i < chunks.size(); ++i)
+        {
+            limbs[i] = chunks[i];
+        }
+
+        if (value.is_negative())
+        {
+            *this = -*this;
+        }
+    }
+
+    /// @brief Parse a number with the same syntax as BigInt.
+    ///
+    /// @throws std::invalid_argument if the string is not a valid number.
+    /// @throws std::overflow_error if the number is out of range.
+    explicit FixedInt(std::string_view num) : FixedInt(BigIntView(BigInt(num)))
+    {
+    }
+
+    /// @brief Construct a number from its limbs, the bits above Bits are ignored.
+    [[nodiscard]] static constexpr auto from_limbs(Limbs const &limbs) noexcept -> FixedInt
+    {
+        FixedInt result;
+        result.limbs = limbs;
+        result.mask();
+        return result;
+    }
+
+    /// @brief Get the smallest number.
+    [[nodiscard]] static constexpr auto min() noexcept -> FixedInt
+    {
+        FixedInt result;
+
+        if constexpr (Signed)
+        {
+            result.set_sign_bit();
+        }
+
+        return result;
+    }
+
+    /// @brief Get the largest number.
+    [[nodiscard]] static constexpr auto max() noexcept -> FixedInt
+    {
+        FixedInt result = ~FixedInt();
+
+        if constexpr (Signed)
+        {
+            result.limbs.back() &= ~sign_mask;
+        }
+
+        return result;
+    }
+
+    /// @brief Get the limbs of the number, in two's complement for negative numbers.
+    [[nodiscard]] constexpr auto get_limbs() const noexcept -> Limbs const &
+    {
+        return limbs;
+    }
+
+    [[nodiscard]] constexpr auto is_negative() const noexcept -> bool
+    {
+        return Signed && (limbs.back() & sign_mask) != 0;
+    }
+
+    [[nodiscard]] constexpr auto is_zero() const noexcept -> bool
+    {
+        bool zero = true;
+        unrolled([&](size_t i) { zero = zero && limbs[i] == 0; });
+        return zero;
+    }
+
+    /// @brief Convert the number to a BigInt.
+    [[nodiscard]] auto to_bigint() const -> BigInt
+    {
+        Limbs const magnitude = is_negative() ? (-*this).limbs : limbs;
+        return BigInt(BigIntView(magnitude, is_negative()));
+    }
+
+    explicit operator BigInt() const
+    {
+        return to_bigint();
+    }
+
+    /// @brief Convert the number to a string, see BigInt::to_string().
+    [[nodiscard]] auto to_string(int base = 10, bool capitalize = false) const -> std::string
+    {
+        return to_bigint().to_string(base, capitalize);
+    }
+
+    [[nodiscard]] constexpr auto operator~() const noexcept -> FixedInt
+    {
+        FixedInt result;
+        unrolled([&](size_t i) { result.limbs[i] = ~limbs[i]; });
+        result.mask();
+        return result;
+    }
+
+    [[nodiscard]] constexpr auto operator-() const noexcept -> FixedInt
+    {
+        return ~*this + FixedInt(1);
+    }
+
+    [[nodiscard]] constexpr auto operator+() const noexcept -> FixedInt
+    {
+        return *this;
+    }
+
+    [[nodiscard]] friend constexpr auto operator+(FixedInt const &lhs, FixedInt const &rhs) noexcept -> FixedInt
+    {
+        FixedInt result;
+        ChunkType carry = 0;
+
+        unrolled(
+            [&](size_t i)
+            {
+                ChunkType const sum = lhs.limbs[i] + rhs.limbs[i];
+                result.limbs[i] = sum + carry;
+                carry = static_cast<ChunkType>(sum < lhs.limbs[i]) | static_cast<ChunkType>(result.limbs[i] < sum);
+            }
+        );
+
+        result.mask();
+        return result;
+    }
+
+    [[nodiscard]] friend constexpr auto operator-(FixedInt const &lhs, FixedInt const &rhs) noexcept -> FixedInt
+    {
+        FixedInt result;
+        ChunkType borrow = 0;
+
+        unrolled(
+            [&](size_t i)
+            {
+                ChunkType const difference = lhs.limbs[i] - rhs.limbs[i];
+                result.limbs[i] = difference - borrow;
+                borrow = static_cast<ChunkType>(lhs.limbs[i] < rhs.limbs[i])
+                         | static_cast<ChunkType>(difference < borrow);
+            }
+        );
+
+        result.mask();
+        return result;
+    }
+
+    /// @details Two's complement products are the same as unsigned ones modulo 2^Bits, so signs need no handling.
+    [[nodiscard]] friend constexpr auto operator*(FixedInt const &lhs, FixedInt const &rhs) noexcept -> FixedInt
+    {
+        FixedInt result;
+
+        // Only the limbs below limb_count are kept, so row i stops at limb_count - i.
+        unrolled(
+            [&](size_t i)
+            {
+                ChunkType carry = 0;
+
+                unrolled(
+                    [&](size_t j)
+                    {
+                        if (i + j < limb_count)
+                        {
+                            auto [low, high] = multiply_limbs(lhs.limbs[j], rhs.limbs[i]);
+                            low += carry;
+                            high += static_cast<ChunkType>(low < carry);
+                            result.limbs[i + j] += low;
+                            high += static_cast<ChunkType>(result.limbs[i + j] < low);
+                            carry = high;
+                        }
+                    }
+                );
+            }
+        );
+
+        result.mask();
+        return result;
+    }
+
+    /// @brief Divide, rounding towards 0 like the built-in types.
+    ///
+    /// @throws std::domain_error if rhs is 0.
+    [[nodiscard]] friend constexpr auto operator/(FixedInt const &lhs, FixedInt const &rhs) -> FixedInt
+    {
+        return divide(lhs, rhs).first;
+    }
+
+    /// @brief Get the remainder of the division, which has the sign of lhs like for the built-in types.
+    ///
+    /// @throws std::domain_error if rhs is 0.
+    [[nodiscard]] friend constexpr auto operator%(FixedInt const &lhs, FixedInt const &rhs) -> FixedInt
+    {
+        return divide(lhs, rhs).second;
+    }
+
+    [[nodiscard]] friend constexpr auto operator&(FixedInt const &lhs, FixedInt const &rhs) noexcept -> FixedInt
+    {
+        FixedInt result;
+        unrolled([&](size_t i) { result.limbs[i] = lhs.limbs[i] & rhs.limbs[i]; });
+        return result;
+    }
+
+    [[nodiscard]] friend constexpr auto operator|(FixedInt const &lhs, FixedInt const &rhs) noexcept -> FixedInt
+    {
+        FixedInt result;
+        unrolled([&](size_t i) { result.limbs[i] = lhs.limbs[i] | rhs.limbs[i]; });
+        return result;
+    }
+
+    [[nodiscard]] friend constexpr auto operator^(FixedInt const &lhs, FixedInt const &rhs) noexcept -> FixedInt
+    {
+        FixedInt result;
+        unrolled([&](size_t i) { result.limbs[i] = lhs.limbs[i] ^ rhs.limbs[i]; });
+        return result;
+    }
+
+    /// @brief Shift left, the bits shifted above Bits are lost.
+    [[nodiscard]] constexpr auto operator<<(size_t shift) const noexcept -> FixedInt
+    {
+        FixedInt result;
+
+        if (shift >= Bits)
+        {
+            return result;
+        }
+
+        size_t const chunk_shift = shift / chunk_bits;
+        size_t const bit_shift = shift % chunk_bits;
+
+        for (size_t i = limb_count; i-- > chunk_shift;)
+        {
+            result.limbs[i] = limbs[i - chunk_shift] << bit_shift;
+
+            if (bit_shift != 0 && i > chunk_shift)
+            {
+                result.limbs[i] |= limbs[i - chunk_shift - 1] >> (chunk_bits - bit_shift);
+            }
+        }
+
+        result.mask();
+        return result;
+    }
+
+    /// @brief Shift right, arithmetically for signed numbers so negative numbers round towards minus infinity.
+    [[nodiscard]] constexpr auto operator>>(size_t shift) const noexcept -> FixedInt
+    {
+        bool const negative = is_negative();
+        // Work on the sign extension to a whole number of limbs, so the shifted in bits are copies of the sign.
+        Limbs extended = limbs;
+
+        if (negative)
+        {
+            extended.back() |= ~top_mask;
+        }
+
+        FixedInt result = negative ? ~FixedInt() : FixedInt();
+
+        if (shift >= Bits)
+        {
+            return result;
+        }
+
+        size_t const chunk_shift = shift / chunk_bits;
+        size_t const bit_shift = shift % chunk_bits;
+        ChunkType const fill = negative ? chunk_max : 0;
+
+        for (size_t i = 0; i + chunk_shift < limb_count; ++i)
+        {
+            ChunkType const next = i + chunk_shift + 1 < limb_count ? extended[i + chunk_shift + 1] : fill;
+            result.limbs[i] = extended[i + chunk_shift] >> bit_shift;
+
+            if (bit_shift != 0)
+            {
+                result.limbs[i] |= next << (chunk_bits - bit_shift);
+            }
+        }
+
+        result.mask();
+        return result;
+    }
+
+    constexpr auto operator+=(FixedInt const &rhs) noexcept -> FixedInt &
+    {
+        return *this = *this + rhs;
+    }
+
+    constexpr auto operator-=(FixedInt const &rhs) noexcept -> FixedInt &
+    {
+        return *this = *this - rhs;
+    }
+
+    constexpr auto operator*=(FixedInt const &rhs) noexcept -> FixedInt &
+    {
+        return *this = *this * rhs;
+    }
+
+    constexpr auto operator/=(FixedInt const &rhs) -> FixedInt &
+    {
+        return *this = *this / rhs;
+    }
+
+    constexpr auto operator%=(FixedInt const &rhs) -> FixedInt &
+    {
+        return *this = *this % rhs;
+    }
+
+    constexpr auto operator<<=(size_t shift) noexcept -> FixedInt &
+    {
+        return *this = *this << shift;
+    }
+
+    constexpr auto operator>>=(size_t shift) noexcept -> FixedInt &
+    {
+        return *this = *this >> shift;
+    }
+
+    [[nodiscard]] friend constexpr auto operator==(FixedInt const &lhs, FixedInt const &rhs) noexcept -> bool = default;
+
+    [[nodiscard]] friend constexpr auto operator<=>(FixedInt const &lhs, FixedInt const &rhs) noexcept
+        -> std::strong_ordering
+    {
+        if (lhs.is_negative() != rhs.is_negative())
+        {
+            return lhs.is_negative() ? std::strong_ordering::less : std::strong_ordering::greater;
+        }
+
+        // Two's complement numbers of the same sign compare like their unsigned patterns.
+        return compare_limbs(lhs.limbs, rhs.limbs);
+    }
+
+private:
+    static constexpr ChunkType chunk_max = std::numeric_limits<ChunkType>::max();
+    /// @brief Mask of the bits of the most significant limb that are part of the number.
+    static constexpr ChunkType top_mask = Bits % chunk_bits == 0 ? chunk_max
+                                                                 : (ChunkType{1} << (Bits % chunk_bits)) - 1;
+    /// @brief Mask of the sign bit in the most significant limb.
+    static constexpr ChunkType sign_mask = ChunkType{1} << ((Bits - 1) % chunk_bits);
+    /// @brief Loops over up to this many limbs are unrolled.
+    static constexpr size_t unroll_limit = 8;
+
+    Limbs limbs{};
+
+    /// @brief Call a function for every limb index, unrolled for narrow numbers.
+    template<typename Function>
+    static constexpr void unrolled(Function const &function)
+    {
+        if constexpr (limb_count <= unroll_limit)
+        {
+            [&]<size_t... I>(std::index_sequence<I...>) { (function(I), ...); }(std::make_index_sequence<limb_count>{});
+        }
+        else
+        {
+            for (size_t i = 0; i < limb_count; ++i)
+            {
+                function(i);
+            }
+        }
+    }
+
+    /// @brief Multiply two limbs into a low and a high limb.
+    [[nodiscard]] static constexpr auto multiply_limbs(ChunkType a, ChunkType b) noexcept
+        -> std::pair<ChunkType, ChunkType>
+    {
+        if constexpr (sizeof(ChunkType) <= 4)
+        {
+            // ChunkType has at least 32 bits, so exactly 32 here.
+            auto const result = static_cast<std::uint64_t>(a) * b;
+            return {static_cast<ChunkType>(result), static_cast<ChunkType>(result >> 32)};
+        }
+        else
+        {
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__SIZEOF_INT128__)
+            __uint128_t const result = static_cast<__uint128_t>(a) * b;
+            return {static_cast<ChunkType>(result), static_cast<ChunkType>(result >> 64)};
+#else
+            // Multiply the 32-bit halves, MSVC's _umul128 can't run at compile time.
+            constexpr std::uint64_t half_mask = 0xFFFF'FFFF;
+            std::uint64_t const a1 = a >> 32;
+            std::uint64_t const a0 = a & half_mask;
+            std::uint64_t const b1 = b >> 32;
+            std::uint64_t const b0 = b & half_mask;
+            std::uint64_t const p0 = a0 * b0;
+            std::uint64_t const p1 = a1 * b0;
+            std::uint64_t const p2 = a0 * b1;
+            std::uint64_t const middle = (p0 >> 32) + (p1 & half_mask) + (p2 & half_mask);
+            std::uint64_t const high = (a1 * b1) + (p1 >> 32) + (p2 >> 32) + (middle >> 32);
+            return {static_cast<ChunkType>((middle << 32) | (p0 & half_mask)), static_cast<ChunkType>(high)};
+#endif
+        }
+    }
+
+    [[nodiscard]] static constexpr auto compare_limbs(Limbs const &lhs, Limbs const &rhs) noexcept
+        -> std::strong_ordering
+    {
+        for (size_t i = limb_count; i-- > 0;)
+        {
+            if (lhs[i] != rhs[i])
+            {
+                return lhs[i] <=> rhs[i];
+            }
+        }
+
+        return std::strong_ordering::equal;
+    }
+
+    [[nodiscard]] static constexpr auto is_power_of_two(std::span<ChunkType const> chunks) noexcept -> bool
+    {
+        for (size_t i = 0; i + 1 < chunks.size(); ++i)
+        {
+            if (chunks[i] != 0)
+            {
+                return false;
+            }
+        }
+
+        return std::has_single_bit(chunks.back());
+    }
+
+    /// @brief Clear the bits above Bits.
+    constexpr void mask() noexcept
+    {
+        limbs.back() &= top_mask;
+    }
+
+    constexpr void set_sign_bit() noexcept
+    {
+        limbs.back() |= sign_mask;
+    }
+
+    /// @brief Divide the magnitudes bit by bit and give the results the signs of the built-in division.
+    [[nodiscard]] static constexpr auto divide(FixedInt const &lhs, FixedInt const &rhs)
+        -> std::pair<FixedInt, FixedInt>
+    {
+        if (rhs.is_zero())
+        {
+            throw std::domain_error("Division by zero");
+        }
+
+        // The magnitude of the smallest signed number is its own pattern, which is right when read as unsigned.
+        Limbs const num = lhs.is_negative() ? (-lhs).limbs : lhs.limbs;
+        Limbs const denom = rhs.is_negative() ? (-rhs).limbs : rhs.limbs;
+        Limbs quotient{};
+        Limbs remainder{};
+
+        for (size_t bit = Bits; bit-- > 0;)
+        {
+            // The remainder is smaller than denom before the shift, so it can only overflow the limbs when Bits is a
+            // multiple of the chunk size, and the carry keeps that bit.
+            ChunkType carry = (num[bit / chunk_bits] >> (bit % chunk_bits)) & 1;
+
+            for (size_t i = 0; i < limb_count; ++i)
+            {
+                ChunkType const next_carry = remainder[i] >> (chunk_bits - 1);
+                remainder[i] = (remainder[i] << 1) | carry;
+                carry = next_carry;
+            }
+
+            if (carry != 0 || compare_limbs(remainder, denom) != std::strong_ordering::less)
+            {
+                ChunkType borrow = 0;
+
+                for (size_t i = 0; i < limb_count; ++i)
+                {
+                    ChunkType const difference = remainder[i] - denom[i];
+                    ChunkType const next_borrow = static_cast<ChunkType>(remainder[i] < denom[i])
+                                                  | static_cast<ChunkType>(difference < borrow);
+                    remainder[i] = difference - borrow;
+                    borrow = next_borrow;
+                }
+
+                quotient[bit / chunk_bits] |= ChunkType{1} << (bit % chunk_bits);
+            }
+        }
+
+        FixedInt q = from_limbs(quotient);
+        FixedInt r = from_limbs(remainder);
+
+        if (lhs.is_negative() != rhs.is_negative())
+        {
+            q = -q;
+        }
+        if (lhs.is_negative())
+        {
+            r = -r;
+        }
+
+        return {q, r};
+    }
+};
+
+}  // namespace BI
+
+template<size_t Bits, bool Signed>
+auto operator<<(std::ostream &os, BI::FixedInt<Bits, Signed> const &num) -> std::ostream &
+{
+    return os << num.to_bigint();
+}
+
+/// @brief Formatter for FixedInt, which supports the same format specification as BigInt.
+template<size_t Bits, bool Signed>
+struct std::formatter<BI::FixedInt<Bits, Signed>> : std::formatter<BI::BigInt>
+{
+    auto format(BI::FixedInt<Bits, Signed> const &num, std::format_context &ctx) const
+        -> std::format_context::iterator
+    {
+        return std::formatter<BI::BigInt>::format(num.to_bigint(), ctx);
+    }
+};
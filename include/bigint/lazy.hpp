@@ -0,0 +1,457 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "bigint.hpp"
+
+namespace BI::detail
+{
+/// @brief One term of a sum evaluated by LazyEvaluator: a number, a product of two numbers or a shifted number.
+struct LazyTerm
+{
+    /// @brief The number, or the first factor of a product.
+    BigIntView value;
+    /// @brief The second factor of a product.
+    BigIntView factor;
+    /// @brief Whether the term is value * factor.
+    bool product{false};
+    /// @brief Number of bits the value is shifted left by.
+    size_t shift{0};
+};
+
+/// @brief Fused kernels evaluating lazy expressions into the storage of a BigInt.
+class LazyEvaluator
+{
+public:
+    /// @brief Set a number to a sum of terms.
+    ///
+    /// The size of the result is bounded from the sizes of the terms, so its buffer is sized once and the terms are
+    /// accumulated into it in two's complement. Products by a single chunk and shifted numbers are added in a single
+    /// pass, other products go through one scratch buffer. The storage of the result is reused, terms viewing the
+    /// result are supported.
+    ///
+    /// @param terms The terms to add.
+    /// @param[out] result The sum.
+    static void sum(std::span<LazyTerm const> terms, BigInt &result);
+
+private:
+    using ChunkType = BigInt::ChunkType;
+
+    /// @brief Write the magnitude of a term at the start of a buffer.
+    ///
+    /// @param term The term, may view the buffer unless it's a product of two numbers of several chunks.
+    /// @param[out] buffer The buffer, large enough for the term.
+    /// @return The number of chunks written.
+    static auto write(LazyTerm const &term, std::span<ChunkType> buffer) -> size_t;
+
+    /// @brief Add a term to a number stored in two's complement.
+    ///
+    /// @param term The term to add, must not view the buffer.
+    /// @param[in,out] buffer The number, large enough for the sum.
+    /// @param scratch Storage for the products of two numbers of several chunks.
+    static void accumulate(LazyTerm const &term, std::span<ChunkType> buffer, std::vector<ChunkType> &scratch);
+};
+
+/// @brief Storage for the terms of a sum and for the subexpressions that have to be evaluated first.
+template<size_t TermCount, size_t TemporaryCount>
+struct LazyFrame
+{
+    std::array<LazyTerm, TermCount> terms{};
+    size_t term_count{0};
+    std::array<BigInt, TemporaryCount> temporaries{};
+    size_t temporary_count{0};
+
+    /// @brief Add the term value * factor if product is set, value << shift otherwise.
+    void add(BigIntView value, BigIntView factor = {}, bool product = false, size_t shift = 0) noexcept
+    {
+        assert(term_count < TermCount);
+        terms[term_count++] = LazyTerm{.value = value, .factor = factor, .product = product, .shift = shift};
+    }
+
+    /// @brief Evaluate a subexpression into a temporary that lives as long as the frame.
+    template<typename Expression>
+    auto materialize(Expression const &expression) -> BigIntView
+    {
+        assert(temporary_count < TemporaryCount);
+        BigInt &temporary = temporaries[temporary_count++];
+        expression.evaluate_to(temporary);
+        return temporary;
+    }
+};
+
+/// @brief Base of the nodes of lazy expressions.
+///
+/// An expression is flattened into a sum of terms, each term being a number, a product or a shift of operands. Operands
+/// that are themselves sums, quotients or remainders are evaluated first into temporaries of the frame.
+///
+/// Nodes define term_count and temporary_count, the sizes of the frame needed by collect(), and
+/// operand_temporary_count, the number of temporaries needed by operand().
+template<typename Derived>
+class LazyExpression
+{
+public:
+    static constexpr size_t operand_temporary_count = 1;
+
+    /// @brief Evaluate the expression into a number, reusing its storage.
+    void evaluate_to(BigInt &result) const
+    {
+        LazyFrame<Derived::term_count, Derived::temporary_count> frame;
+        derived().collect(frame, false);
+        LazyEvaluator::sum(std::span<LazyTerm const>(frame.terms).first(frame.term_count), result);
+    }
+
+    /// @brief Get a view of the value of the expression to use as an operand.
+    template<typename Frame>
+    auto operand(Frame &frame) const -> BigIntView
+    {
+        return frame.materialize(derived());
+    }
+
+private:
+    LazyExpression() = default;
+    friend Derived;
+
+    [[nodiscard]] auto derived() const noexcept -> Derived const &
+    {
+        return static_cast<Derived const &>(*this);
+    }
+};
+
+template<typename T>
+concept Lazy = std::derived_from<T, LazyExpression<T>>;
+
+/// @brief Number referenced by an expression.
+class LazyNumber : public LazyExpression<LazyNumber>
+{
+public:
+    static constexpr size_t term_count = 1;
+    static constexpr size_t temporary_count = 0;
+    static constexpr size_t operand_temporary_count = 0;
+
+    constexpr explicit LazyNumber(BigIntView num) noexcept : value{num}
+    {
+    }
+
+    template<typename Frame>
+    void collect(Frame &frame, bool negate) const noexcept
+    {
+        frame.add(negate ? -value : value);
+    }
+
+    template<typename Frame>
+    auto operand(Frame & /* frame */) const noexcept -> BigIntView
+    {
+        return value;
+    }
+
+private:
+    BigIntView value;
+};
+
+/// @brief Integer stored in an expression, products by it use the kernels for single chunks.
+class LazySmallNumber : public LazyExpression<LazySmallNumber>
+{
+public:
+    using ChunkType = BigInt::ChunkType;
+
+    static constexpr size_t term_count = 1;
+    static constexpr size_t temporary_count = 0;
+    static constexpr size_t operand_temporary_count = 0;
+
+    template<std::integral T>
+    constexpr explicit LazySmallNumber(T num) noexcept : negative{num < 0}
+    {
+        using Unsigned = std::make_unsigned_t<T>;
+
+        auto const magnitude = static_cast<std::uintmax_t>(
+            negative ? static_cast<Unsigned>(Unsigned{0} - static_cast<Unsigned>(num)) : static_cast<Unsigned>(num)
+        );
+
+        for (size_t i = 0; i < chunks.size(); ++i)
+        {
+            chunks[i] = static_cast<ChunkType>(magnitude >> (i * sizeof(ChunkType) * 8));
+        }
+    }
+
+    template<typename Frame>
+    void collect(Frame &frame, bool negate) const noexcept
+    {
+        frame.add(view(negate));
+    }
+
+    template<typename Frame>
+    auto operand(Frame & /* frame */) const noexcept -> BigIntView
+    {
+        return view(false);
+    }
+
+private:
+    std::array<ChunkType, (sizeof(std::uintmax_t) + sizeof(ChunkType) - 1) / sizeof(ChunkType)> chunks{};
+    bool negative;
+
+    [[nodiscard]] constexpr auto view(bool negate) const noexcept -> BigIntView
+    {
+        return BigIntView(chunks, negative != negate);
+    }
+};
+
+/// @brief Negation of an expression.
+template<Lazy Operand>
+class LazyNegation : public LazyExpression<LazyNegation<Operand>>
+{
+public:
+    static constexpr size_t term_count = Operand::term_count;
+    static constexpr size_t temporary_count = Operand::temporary_count;
+    static constexpr size_t operand_temporary_count = Operand::operand_temporary_count;
+
+    constexpr explicit LazyNegation(Operand const &operand) noexcept : inner{operand}
+    {
+    }
+
+    template<typename Frame>
+    void collect(Frame &frame, bool negate) const
+    {
+        inner.collect(frame, !negate);
+    }
+
+    template<typename Frame>
+    auto operand(Frame &frame) const -> BigIntView
+    {
+        return -inner.operand(frame);
+    }
+
+private:
+    Operand inner;
+};
+
+/// @brief Sum or difference of two expressions, flattened with the terms of both.
+template<Lazy Lhs, Lazy Rhs, bool Subtract>
+class LazySum : public LazyExpression<LazySum<Lhs, Rhs, Subtract>>
+{
+public:
+    static constexpr size_t term_count = Lhs::term_count + Rhs::term_count;
+    static constexpr size_t temporary_count = Lhs::temporary_count + Rhs::temporary_count;
+
+    constexpr LazySum(Lhs const &lhs_operand, Rhs const &rhs_operand) noexcept : lhs{lhs_operand}, rhs{rhs_operand}
+    {
+    }
+
+    template<typename Frame>
+    void collect(Frame &frame, bool negate) const
+    {
+        lhs.collect(frame, negate);
+        rhs.collect(frame, negate != Subtract);
+    }
+
+private:
+    Lhs lhs;
+    Rhs rhs;
+};
+
+/// @brief Product of two expressions, a single term.
+template<Lazy Lhs, Lazy Rhs>
+class LazyProduct : public LazyExpression<LazyProduct<Lhs, Rhs>>
+{
+public:
+    static constexpr size_t term_count = 1;
+    static constexpr size_t temporary_count = Lhs::operand_temporary_count + Rhs::operand_temporary_count;
+
+    constexpr LazyProduct(Lhs const &lhs_operand, Rhs const &rhs_operand) noexcept : lhs{lhs_operand}, rhs{rhs_operand}
+    {
+    }
+
+    template<typename Frame>
+    void collect(Frame &frame, bool negate) const
+    {
+        BigIntView const value = lhs.operand(frame);
+        frame.add(negate ? -value : value, rhs.operand(frame), true);
+    }
+
+private:
+    Lhs lhs;
+    Rhs rhs;
+};
+
+/// @brief Expression shifted left, a single term.
+template<Lazy Operand>
+class LazyShift : public LazyExpression<LazyShift<Operand>>
+{
+public:
+    static constexpr size_t term_count = 1;
+    static constexpr size_t temporary_count = Operand::operand_temporary_count;
+
+    constexpr LazyShift(Operand const &operand, size_t shift_bits) noexcept : inner{operand}, shift{shift_bits}
+    {
+    }
+
+    template<typename Frame>
+    void collect(Frame &frame, bool negate) const
+    {
+        BigIntView const value = inner.operand(frame);
+        frame.add(negate ? -value : value, {}, false, shift);
+    }
+
+private:
+    Operand inner;
+    size_t shift;
+};
+
+/// @brief Quotient or remainder of two expressions. The dividend is evaluated in the result, which is then divided.
+template<Lazy Lhs, Lazy Rhs, bool Remainder>
+class LazyDivision : public LazyExpression<LazyDivision<Lhs, Rhs, Remainder>>
+{
+public:
+    static constexpr size_t term_count = 1;
+    static constexpr size_t temporary_count = 1;
+
+    constexpr LazyDivision(Lhs const &lhs_operand, Rhs const &rhs_operand) noexcept : lhs{lhs_operand}, rhs{rhs_operand}
+    {
+    }
+
+    /// @throws std::domain_error if the divisor is 0.
+    void evaluate_to(BigInt &result) const
+    {
+        LazyFrame<0, Rhs::operand_temporary_count> frame;
+        BigIntView divisor = rhs.operand(frame);
+        BigInt divisor_copy;
+
+        if (divisor.is_zero())
+        {
+            throw std::domain_error("Division by zero");
+        }
+
+        // The dividend is evaluated in the result first, a divisor viewing the result has to be copied.
+        if (divisor.chunks().data() == BigIntView(result).chunks().data())
+        {
+            divisor_copy = BigInt(divisor);
+            divisor = divisor_copy;
+        }
+
+        lhs.evaluate_to(result);
+        result = Remainder ? BigIntView(result) % divisor : BigIntView(result) / divisor;
+    }
+
+    template<typename Frame>
+    void collect(Frame &frame, bool negate) const
+    {
+        BigIntView const value = frame.materialize(*this);
+        frame.add(negate ? -value : value);
+    }
+
+private:
+    Lhs lhs;
+    Rhs rhs;
+};
+
+template<typename T>
+concept LazyOperand = Lazy<T> || std::integral<T> || std::convertible_to<T const &, BigIntView>;
+
+/// @brief Get the expression node of an operand.
+template<LazyOperand T>
+constexpr auto to_lazy(T const &operand) noexcept
+{
+    if constexpr (Lazy<T>)
+    {
+        return operand;
+    }
+    else if constexpr (std::integral<T>)
+    {
+        return LazySmallNumber(operand);
+    }
+    else
+    {
+        return LazyNumber(BigIntView(operand));
+    }
+}
+
+template<typename T>
+using LazyNode = decltype(to_lazy(std::declval<T const &>()));
+
+/// @brief Whether an operator builds an expression: one operand is an expression and the other can be one.
+template<typename Lhs, typename Rhs>
+concept LazyOperands = (Lazy<Lhs> && LazyOperand<Rhs>) || (LazyOperand<Lhs> && Lazy<Rhs>);
+
+template<Lazy Operand>
+[[nodiscard]] constexpr auto operator-(Operand const &operand) noexcept -> LazyNegation<Operand>
+{
+    return LazyNegation<Operand>(operand);
+}
+
+template<typename Lhs, typename Rhs>
+    requires LazyOperands<Lhs, Rhs>
+[[nodiscard]] constexpr auto operator+(Lhs const &lhs, Rhs const &rhs) noexcept
+    -> LazySum<LazyNode<Lhs>, LazyNode<Rhs>, false>
+{
+    return {to_lazy(lhs), to_lazy(rhs)};
+}
+
+template<typename Lhs, typename Rhs>
+    requires LazyOperands<Lhs, Rhs>
+[[nodiscard]] constexpr auto operator-(Lhs const &lhs, Rhs const &rhs) noexcept
+    -> LazySum<LazyNode<Lhs>, LazyNode<Rhs>, true>
+{
+    return {to_lazy(lhs), to_lazy(rhs)};
+}
+
+template<typename Lhs, typename Rhs>
+    requires LazyOperands<Lhs, Rhs>
+[[nodiscard]] constexpr auto operator*(Lhs const &lhs, Rhs const &rhs) noexcept
+    -> LazyProduct<LazyNode<Lhs>, LazyNode<Rhs>>
+{
+    return {to_lazy(lhs), to_lazy(rhs)};
+}
+
+template<typename Lhs, typename Rhs>
+    requires LazyOperands<Lhs, Rhs>
+[[nodiscard]] constexpr auto operator/(Lhs const &lhs, Rhs const &rhs) noexcept
+    -> LazyDivision<LazyNode<Lhs>, LazyNode<Rhs>, false>
+{
+    return {to_lazy(lhs), to_lazy(rhs)};
+}
+
+template<typename Lhs, typename Rhs>
+    requires LazyOperands<Lhs, Rhs>
+[[nodiscard]] constexpr auto operator%(Lhs const &lhs, Rhs const &rhs) noexcept
+    -> LazyDivision<LazyNode<Lhs>, LazyNode<Rhs>, true>
+{
+    return {to_lazy(lhs), to_lazy(rhs)};
+}
+
+template<Lazy Operand>
+[[nodiscard]] constexpr auto operator<<(Operand const &operand, size_t shift) noexcept -> LazyShift<Operand>
+{
+    return {operand, shift};
+}
+}  // namespace BI::detail
+
+namespace BI
+{
+/// @brief Start a lazy expression.
+///
+/// Operators on the returned node and on the nodes built from it record the expression instead of computing it, the
+/// expression is evaluated when it's assigned to a BigInt:
+///
+/// @code
+/// r = (BI::lazy(a) * b + BI::lazy(c) * d) % m;
+/// x = BI::lazy(x) * 2 + y;
+/// @endcode
+///
+/// Sums of products, shifts and numbers are computed in a single buffer sized once, reusing the storage of the assigned
+/// number. Expressions only reference their operands, so they must be evaluated before the operands change or are
+/// destroyed, which is always the case when they are assigned in the statement that builds them.
+///
+/// @param num The first operand.
+[[nodiscard]] constexpr auto lazy(BigIntView num) noexcept -> detail::LazyNumber
+{
+    return detail::LazyNumber(num);
+}
+}  // namespace BI
@@ -0,0 +1,278 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <format>
+#include <span>
+#include <stdexcept>
+
+#include "bigint.hpp"
+#include "montgomery.hpp"
+
+namespace BI
+{
+/// @brief Arithmetic modulo a fixed odd modulus, on residues stored in fixed-size arrays.
+///
+/// The Montgomery constants of the modulus are computed once when the context is created. Residues are kept in
+/// Montgomery form, so multiplications reduce with single chunk multiplications instead of a division, and all
+/// operations except conversions and inversion work on the stack without allocating.
+///
+/// @tparam Chunks Number of chunks of every residue, the modulus must fit in them.
+template<size_t Chunks>
+class ModContext
+{
+public:
+    static_assert(Chunks > 0, "Residues must have at least one chunk");
+
+    using ChunkType = BigInt::ChunkType;
+
+    /// @brief A residue in Montgomery form. Only the first size() chunks are used, the rest stay 0.
+    using Residue = std::array<ChunkType, Chunks>;
+
+    /// @brief Precompute the constants for a modulus.
+    ///
+    /// @param modulus The modulus, must be odd and greater than 1. Only its magnitude is used.
+    ///
+    /// @throws std::domain_error if the modulus is even or smaller than 2.
+    /// @throws std::overflow_error if the modulus doesn't fit in Chunks chunks.
+    explicit ModContext(BigIntView modulus) : montgomery{modulus.abs()}
+    {
+        if (montgomery.size() > Chunks)
+        {
+            throw std::overflow_error(std::format("Modulus doesn't fit in {} chunks", Chunks));
+        }
+    }
+
+    /// @brief Get the number of chunks used by the residues.
+    [[nodiscard]] auto size() const noexcept -> size_t
+    {
+        return montgomery.size();
+    }
+
+    /// @brief Get the modulus.
+    [[nodiscard]] auto modulus() const -> BigInt
+    {
+        return BigInt(BigIntView(montgomery.get_modulus()));
+    }
+
+    /// @brief Convert a number to a residue.
+    ///
+    /// @param value The number to convert, may be negative or larger than the modulus.
+    [[nodiscard]] auto residue(BigIntView value) const -> Residue
+    {
+        Residue result{};
+        montgomery.to_montgomery(value, used(result));
+        return result;
+    }
+
+    /// @brief Convert a residue to a number in [0, modulus).
+    [[nodiscard]] auto value(Residue const &residue) const -> BigInt
+    {
+        return montgomery.from_montgomery(used(residue));
+    }
+
+    /// @brief Get the residue of 1.
+    [[nodiscard]] auto one() const noexcept -> Residue
+    {
+        Residue result{};
+        std::ranges::copy(montgomery.one(), result.begin());
+        return result;
+    }
+
+    [[nodiscard]] auto add(Residue const &lhs, Residue const &rhs) const noexcept -> Residue
+    {
+        Residue result{};
+        montgomery.add(used(lhs), used(rhs), used(result));
+        return result;
+    }
+
+    [[nodiscard]] auto sub(Residue const &lhs, Residue const &rhs) const noexcept -> Residue
+    {
+        Residue result{};
+        montgomery.subtract(used(lhs), used(rhs), used(result));
+        return result;
+    }
+
+    [[nodiscard]] auto mul(Residue const &lhs, Residue const &rhs) const noexcept -> Residue
+    {
+        Residue result{};
+        std::array<ChunkType, Chunks + 2> scratch{};
+        montgomery.multiply(used(lhs), used(rhs), used(result), scratch);
+        return result;
+    }
+
+    [[nodiscard]] auto sqr(Residue const &residue) const noexcept -> Residue
+    {
+        return mul(residue, residue);
+    }
+
+    /// @brief Get the inverse of a residue.
+    ///
+    /// @throws std::domain_error if the residue is not coprime with the modulus.
+    [[nodiscard]] auto inv(Residue const &residue) const -> Residue
+    {
+        return this->residue(invert(value(residue), modulus()));
+    }
+
+    /// @brief Raise a residue to a power.
+    ///
+    /// @param base The residue to raise.
+    /// @param exponent The power, a negative power raises the inverse of the base.
+    ///
+    /// @throws std::domain_error if the exponent is negative and the base is not invertible.
+    [[nodiscard]] auto pow(Residue const &base, BigIntView exponent) const -> Residue
+    {
+        if (exponent.is_negative())
+        {
+            return pow(inv(base), exponent.abs());
+        }
+
+        // Fixed 4-bit windows, the powers of the base are kept on the stack.
+        constexpr size_t window = 4;
+        constexpr size_t chunk_bits = sizeof(ChunkType) * 8;
+        static_assert(chunk_bits % window == 0, "Windows must not span two chunks");
+
+        std::array<Residue, static_cast<size_t>(1) << window> powers{one(), base};
+
+        for (size_t i = 2; i < powers.size(); ++i)
+        {
+            powers[i] = mul(powers[i - 1], base);
+        }
+
+        std::span<ChunkType const> const exponent_chunks = exponent.chunks();
+        Residue result = one();
+
+        for (size_t position = exponent_chunks.size() * chunk_bits; position > 0; position -= window)
+        {
+            for (size_t i = 0; i < window; ++i)
+            {
+                result = sqr(result);
+            }
+
+            size_t const low_bit = position - window;
+            ChunkType const digit =
+                (exponent_chunks[low_bit / chunk_bits] >> (low_bit % chunk_bits)) & (powers.size() - 1);
+
+            if (digit != 0)
+            {
+                result = mul(result, powers[digit]);
+            }
+        }
+
+        return result;
+    }
+
+private:
+    detail::Montgomery montgomery;
+
+    /// @brief Get the chunks of a residue that are used by the modulus.
+    [[nodiscard]] auto used(Residue &residue) const noexcept -> std::span<ChunkType>
+    {
+        return std::span(residue).first(size());
+    }
+
+    [[nodiscard]] auto used(Residue const &residue) const noexcept -> std::span<ChunkType const>
+    {
+        return std::span(residue).first(size());
+    }
+};
+
+/// @brief A residue bound to the context it belongs to, with the usual arithmetic operators.
+///
+/// The context must outlive the residue. Like the context, none of the operators except inversion allocate.
+///
+/// @tparam Chunks Number of chunks of the residue.
+template<size_t Chunks>
+class ModInt
+{
+public:
+    using Context = ModContext<Chunks>;
+
+    /// @brief Construct the residue of a number.
+    ModInt(Context const &mod_context, BigIntView num) : context{&mod_context}, residue{mod_context.residue(num)} {}
+
+    /// @brief Construct from a residue created by the context.
+    ModInt(Context const &mod_context, typename Context::Residue const &num) noexcept
+        : context{&mod_context}, residue{num}
+    {
+    }
+
+    /// @brief Get the number in [0, modulus) represented by the residue.
+    [[nodiscard]] auto value() const -> BigInt
+    {
+        return context->value(residue);
+    }
+
+    /// @brief Get the residue in Montgomery form.
+    [[nodiscard]] auto get_residue() const noexcept -> typename Context::Residue const &
+    {
+        return residue;
+    }
+
+    [[nodiscard]] auto pow(BigIntView exponent) const -> ModInt
+    {
+        return {*context, context->pow(residue, exponent)};
+    }
+
+    [[nodiscard]] auto inv() const -> ModInt
+    {
+        return {*context, context->inv(residue)};
+    }
+
+    auto operator+(ModInt const &rhs) const noexcept -> ModInt
+    {
+        assert(context == rhs.context);
+        return {*context, context->add(residue, rhs.residue)};
+    }
+
+    auto operator-(ModInt const &rhs) const noexcept -> ModInt
+    {
+        assert(context == rhs.context);
+        return {*context, context->sub(residue, rhs.residue)};
+    }
+
+    auto operator*(ModInt const &rhs) const noexcept -> ModInt
+    {
+        assert(context == rhs.context);
+        return {*context, context->mul(residue, rhs.residue)};
+    }
+
+    /// @throws std::domain_error if rhs is not invertible.
+    auto operator/(ModInt const &rhs) const -> ModInt
+    {
+        return *this * rhs.inv();
+    }
+
+    auto operator+=(ModInt const &rhs) noexcept -> ModInt &
+    {
+        return *this = *this + rhs;
+    }
+
+    auto operator-=(ModInt const &rhs) noexcept -> ModInt &
+    {
+        return *this = *this - rhs;
+    }
+
+    auto operator*=(ModInt const &rhs) noexcept -> ModInt &
+    {
+        return *this = *this * rhs;
+    }
+
+    auto operator/=(ModInt const &rhs) -> ModInt &
+    {
+        return *this = *this / rhs;
+    }
+
+    /// @brief Residues are always fully reduced, so equal numbers have equal residues.
+    auto operator==(ModInt const &rhs) const noexcept -> bool
+    {
+        return context == rhs.context && residue == rhs.residue;
+    }
+
+private:
+    Context const *context;
+    typename Context::Residue residue;
+};
+}  // namespace BI
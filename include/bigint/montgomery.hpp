@@ -0,0 +1,98 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "bigint.hpp"
+
+namespace BI::detail
+{
+/// @brief Montgomery multiplication modulo a fixed odd modulus.
+///
+/// Residues are stored in Montgomery form (x * R mod m, with R = 2^(chunk_bits * size())) as exactly size() chunks in
+/// little endian. The operations don't allocate and don't branch on the values of the residues, so they can be used
+/// with secret data.
+class Montgomery
+{
+public:
+    using ChunkType = BigInt::ChunkType;
+
+    /// @brief Precompute the constants for a modulus.
+    ///
+    /// @param modulus The modulus, must be odd and greater than 1.
+    ///
+    /// @throws std::domain_error if the modulus is even or smaller than 2.
+    explicit Montgomery(BigIntView modulus);
+
+    /// @brief Get the number of chunks of every residue.
+    [[nodiscard]] auto size() const noexcept -> size_t
+    {
+        return modulus.size();
+    }
+
+    /// @brief Get the number of scratch chunks needed by multiply().
+    [[nodiscard]] auto scratch_size() const noexcept -> size_t
+    {
+        return modulus.size() + 2;
+    }
+
+    /// @brief Get the modulus, which has exactly size() chunks.
+    [[nodiscard]] auto get_modulus() const noexcept -> std::span<ChunkType const>
+    {
+        return modulus;
+    }
+
+    /// @brief Get 1 in Montgomery form.
+    [[nodiscard]] auto one() const noexcept -> std::span<ChunkType const>
+    {
+        return r_mod;
+    }
+
+    /// @brief Multiply two residues with the CIOS method, result = lhs * rhs / R mod m.
+    ///
+    /// @param lhs The first residue.
+    /// @param rhs The second residue.
+    /// @param[out] result The product, may alias lhs or rhs.
+    /// @param scratch Temporary storage of scratch_size() chunks.
+    void multiply(
+        std::span<ChunkType const> lhs,
+        std::span<ChunkType const> rhs,
+        std::span<ChunkType> result,
+        std::span<ChunkType> scratch
+    ) const noexcept;
+
+    /// @brief Add two residues, result = lhs + rhs mod m. result may alias lhs or rhs.
+    void add(std::span<ChunkType const> lhs, std::span<ChunkType const> rhs, std::span<ChunkType> result)
+        const noexcept;
+
+    /// @brief Subtract two residues, result = lhs - rhs mod m. result may alias lhs or rhs.
+    void subtract(std::span<ChunkType const> lhs, std::span<ChunkType const> rhs, std::span<ChunkType> result)
+        const noexcept;
+
+    /// @brief Convert a number to Montgomery form.
+    ///
+    /// @param value The number to convert, may be negative or larger than the modulus.
+    /// @param[out] result The residue of value * R mod m.
+    void to_montgomery(BigIntView value, std::span<ChunkType> result) const;
+
+    /// @brief Convert a residue from Montgomery form to a number in [0, m).
+    [[nodiscard]] auto from_montgomery(std::span<ChunkType const> residue) const -> BigInt;
+
+private:
+    /// @brief Chunks of the modulus.
+    std::vector<ChunkType> modulus;
+    /// @brief -m^-1 mod 2^chunk_bits.
+    ChunkType inverse{};
+    /// @brief R mod m, which is 1 in Montgomery form.
+    std::vector<ChunkType> r_mod;
+    /// @brief R^2 mod m, used to convert numbers to Montgomery form.
+    std::vector<ChunkType> r_squared;
+
+    /// @brief Subtract the modulus from a value smaller than 2m if it's not smaller than m, without branching.
+    ///
+    /// @param low The lowest size() chunks of the value.
+    /// @param high The chunk above low, 0 or 1.
+    /// @param[out] result The reduced value, may alias low.
+    void reduce_once(std::span<ChunkType const> low, ChunkType high, std::span<ChunkType> result) const noexcept;
+};
+}  // namespace BI::detail
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+
+#include "bigint.hpp"
+#include "shared_bigint.hpp"
+
+namespace BI
+{
+/// @brief Default limit of the memory used by the chunks of the cached powers, in bytes.
+inline constexpr size_t default_power_cache_limit = size_t{16} << 20;
+
+/// @brief Get a power of a base from a cache shared by every thread.
+///
+/// Missing powers are computed outside of the cache lock by squaring the cached power of half the exponent, so the
+/// powers used by base conversions (base^(d * 2^i)) are built from each other. Powers of two are built directly. The
+/// least recently used powers are dropped when the cache grows past its limit, the returned number stays valid as long
+/// as it's held.
+///
+/// @param base The base, at least 2.
+/// @param exponent The exponent.
+/// @return base^exponent.
+///
+/// @throws std::invalid_argument if the base is smaller than 2.
+[[nodiscard]] auto cached_power(BigInt::ChunkType base, size_t exponent) -> SharedBigInt;
+
+/// @brief Get the limit of the memory used by the cached powers, in bytes.
+[[nodiscard]] auto get_power_cache_limit() -> size_t;
+
+/// @brief Set the limit of the memory used by the cached powers, dropping powers until it's respected.
+///
+/// @param bytes The limit in bytes, 0 disables the cache.
+void set_power_cache_limit(size_t bytes);
+
+/// @brief Get the memory used by the cached powers, in bytes.
+[[nodiscard]] auto get_power_cache_usage() -> size_t;
+
+/// @brief Drop every cached power.
+void clear_power_cache();
+}  // namespace BI
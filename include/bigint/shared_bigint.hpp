@@ -0,0 +1,133 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <format>
+#include <iosfwd>
+#include <utility>
+
+#include "bigint.hpp"
+
+namespace BI
+{
+/// @brief Immutable number whose storage is shared by its copies and copied only when one of them is modified.
+///
+/// Copies only increment an atomic reference count, so a large constant can be cached and handed to many threads
+/// without duplicating its chunks. Like std::shared_ptr, different objects sharing the same number can be used from
+/// different threads, but a single object must not be modified while another thread uses it. The number is read
+/// through BigIntView, which every function taking a view accepts.
+class SharedBigInt
+{
+public:
+    /// @brief Construct a shared 0, without allocating.
+    SharedBigInt() noexcept = default;
+
+    /// @brief Construct a shared number from a BigInt, taking over its chunks.
+    explicit SharedBigInt(BigInt num);
+
+    /// @brief Construct a shared number by copying the value of a view.
+    explicit SharedBigInt(BigIntView num);
+
+    SharedBigInt(SharedBigInt const &rhs) noexcept : block{rhs.block}
+    {
+        if (block != nullptr)
+        {
+            block->references.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    SharedBigInt(SharedBigInt &&rhs) noexcept : block{std::exchange(rhs.block, nullptr)}
+    {
+    }
+
+    ~SharedBigInt()
+    {
+        release();
+    }
+
+    auto operator=(SharedBigInt const &rhs) noexcept -> SharedBigInt &
+    {
+        SharedBigInt(rhs).swap(*this);
+        return *this;
+    }
+
+    auto operator=(SharedBigInt &&rhs) noexcept -> SharedBigInt &
+    {
+        SharedBigInt(std::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    /// @brief Replace the number, reusing the storage if it isn't shared.
+    auto operator=(BigInt num) -> SharedBigInt &;
+
+    /// @brief Get a view of the number, valid until this object is modified or destroyed.
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    operator BigIntView() const noexcept
+    {
+        return block != nullptr ? BigIntView(block->value) : BigIntView();
+    }
+
+    /// @brief Get the number, valid until this object is modified or destroyed.
+    [[nodiscard]] auto get() const noexcept -> BigInt const &;
+
+    /// @brief Get the number of objects sharing the number, 0 for a default constructed object.
+    [[nodiscard]] auto use_count() const noexcept -> size_t
+    {
+        return block != nullptr ? block->references.load(std::memory_order_relaxed) : 0;
+    }
+
+    /// @brief Get the number to modify it, copying it first if it's shared with other objects.
+    ///
+    /// The reference is invalidated when this object is copied, assigned or destroyed.
+    [[nodiscard]] auto mutate() -> BigInt &;
+
+    void swap(SharedBigInt &other) noexcept
+    {
+        std::swap(block, other.block);
+    }
+
+    friend void swap(SharedBigInt &lhs, SharedBigInt &rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+private:
+    /// @brief Storage shared by the copies of a number.
+    struct Block
+    {
+        explicit Block(BigInt num) noexcept : value{std::move(num)}
+        {
+        }
+
+        std::atomic<size_t> references{1};
+        BigInt value;
+    };
+
+    /// @brief Shared storage, null for 0.
+    Block *block{nullptr};
+
+    /// @brief Drop the reference to the storage, deleting it if it was the last one.
+    void release() noexcept;
+};
+}  // namespace BI
+
+auto operator<<(std::ostream &os, BI::SharedBigInt const &num) -> std::ostream &;
+
+/// @brief Formatter for SharedBigInt, which supports the same format specification as BigInt.
+template<>
+struct std::formatter<BI::SharedBigInt> : std::formatter<BI::BigInt>
+{
+    auto format(BI::SharedBigInt const &num, std::format_context &ctx) const -> std::format_context::iterator
+    {
+        return std::formatter<BI::BigInt>::format(num.get(), ctx);
+    }
+};
+
+template<>
+struct std::hash<BI::SharedBigInt>
+{
+    auto operator()(BI::SharedBigInt const &num) const noexcept -> size_t
+    {
+        return std::hash<BI::BigIntView>()(num);
+    }
+};
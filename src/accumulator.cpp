@@ -0,0 +1,73 @@
+#include "bigint/accumulator.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+using namespace BI;
+
+auto Accumulator::merge(Accumulator const &other) -> Accumulator &
+{
+    // The other sums are added as single numbers, so the carry counts stay bounded by the number of additions.
+    std::vector<ChunkType> const other_positive = other.positive.normalize();
+    std::vector<ChunkType> const other_negative = other.negative.normalize();
+    positive.add(other_positive);
+    negative.add(other_negative);
+    return *this;
+}
+
+auto Accumulator::result() const -> BigInt
+{
+    std::vector<ChunkType> const positive_sum = positive.normalize();
+    std::vector<ChunkType> const negative_sum = negative.normalize();
+    return BigIntView(positive_sum) - BigIntView(negative_sum);
+}
+
+void Accumulator::clear() noexcept
+{
+    positive.clear();
+    negative.clear();
+}
+
+auto Accumulator::Lanes::normalize() const -> std::vector<ChunkType>
+{
+    std::vector<ChunkType> result(low.size());
+    ChunkType carry = 0;
+
+    for (size_t i = 0; i < low.size(); ++i)
+    {
+        result[i] = low[i] + carry;
+        // Every count is smaller than the number of additions, so adding one more can't overflow.
+        carry = carries[i] + static_cast<ChunkType>(result[i] < carry);
+    }
+
+    if (carry != 0)
+    {
+        result.push_back(carry);
+    }
+
+    return result;
+}
+
+void Accumulator::Lanes::clear() noexcept
+{
+    std::ranges::fill(low, 0);
+    std::ranges::fill(carries, 0);
+    additions = 0;
+}
+
+void Accumulator::Lanes::grow(size_t size)
+{
+    if (additions == std::numeric_limits<ChunkType>::max())
+    {
+        low = normalize();
+        carries.assign(low.size(), 0);
+        additions = 0;
+    }
+
+    if (size > low.size())
+    {
+        low.resize(size, 0);
+        carries.resize(size, 0);
+    }
+}
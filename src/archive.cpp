@@ -0,0 +1,237 @@
+#include "bigint/archive.hpp"
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+#if defined(__unix__) || defined(__APPLE__)
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+
+#   include <cerrno>
+#endif
+
+using namespace BI;
+
+namespace
+{
+/// @brief Header at the start of every archive file.
+struct ArchiveHeader
+{
+    std::array<char, 8> magic;
+    /// @brief Written in the native byte order to detect archives from platforms with another byte order.
+    std::uint64_t byte_order_mark;
+    std::uint64_t chunk_size;
+    std::uint64_t count;
+};
+
+constexpr std::array<char, 8> archive_magic{'B', 'I', 'G', 'I', 'N', 'T', 'A', '1'};
+constexpr std::uint64_t archive_byte_order_mark = 0x0102030405060708;
+
+static_assert(sizeof(ArchiveHeader) == 32, "ArchiveHeader must not have padding");
+static_assert(alignof(BigInt::ChunkType) <= alignof(std::uint64_t), "Chunks must be aligned by the index");
+}  // namespace
+
+BigIntArchive::BigIntArchive(std::filesystem::path const &path)
+{
+    auto invalid_archive = [&path](std::string_view reason)
+    {
+        return std::invalid_argument(std::format("\"{}\" is not a valid archive: {}", path.string(), reason));
+    };
+
+    std::byte const *data = nullptr;
+    size_t size = 0;
+
+#if defined(__unix__) || defined(__APPLE__)
+    auto throw_system_error = [&path](std::string_view action)
+    {
+        throw std::system_error(
+            errno, std::generic_category(), std::format("Failed to {} \"{}\"", action, path.string())
+        );
+    };
+
+    int const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0)
+    {
+        throw_system_error("open");
+    }
+
+    struct stat info{};
+
+    if (::fstat(fd, &info) != 0)
+    {
+        ::close(fd);
+        throw_system_error("read");
+    }
+
+    size = static_cast<size_t>(info.st_size);
+
+    if (size < sizeof(ArchiveHeader))
+    {
+        ::close(fd);
+        throw invalid_archive("file is too small");
+    }
+
+    void *const mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid after the file is closed.
+    ::close(fd);
+
+    if (mapping == MAP_FAILED)
+    {
+        throw_system_error("map");
+    }
+
+    // Values are usually accessed in any order, so read ahead is not useful.
+    ::madvise(mapping, size, MADV_RANDOM);
+
+    storage = std::shared_ptr<void const>(
+        mapping,
+        [size](void const *ptr)
+        {
+            // munmap() takes a mutable pointer but the mapping is only ever read.
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+            ::munmap(const_cast<void *>(ptr), size);
+        }
+    );
+    data = static_cast<std::byte const *>(mapping);
+#else
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+
+    if (!file)
+    {
+        throw std::system_error(
+            std::make_error_code(std::errc::no_such_file_or_directory),
+            std::format("Failed to open \"{}\"", path.string())
+        );
+    }
+
+    size = static_cast<size_t>(file.tellg());
+
+    if (size < sizeof(ArchiveHeader))
+    {
+        throw invalid_archive("file is too small");
+    }
+
+    // Read the file into 64-bit words so the index and the chunks are aligned.
+    size_t const words = (size + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+    auto buffer = std::make_shared<std::vector<std::uint64_t>>(words);
+    file.seekg(0);
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    if (!file.read(reinterpret_cast<char *>(buffer->data()), static_cast<std::streamsize>(size)))
+    {
+        throw std::system_error(
+            std::make_error_code(std::errc::io_error), std::format("Failed to read \"{}\"", path.string())
+        );
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    data = reinterpret_cast<std::byte const *>(buffer->data());
+    storage = std::move(buffer);
+#endif
+
+    ArchiveHeader header{};
+    std::memcpy(&header, data, sizeof(header));
+
+    if (header.magic != archive_magic)
+    {
+        throw invalid_archive("unknown file format");
+    }
+    if (header.byte_order_mark != archive_byte_order_mark)
+    {
+        throw invalid_archive("written with a different byte order");
+    }
+    if (header.chunk_size != sizeof(ChunkType))
+    {
+        throw invalid_archive("written with a different chunk size");
+    }
+
+    size_t const available_entries = (size - sizeof(ArchiveHeader)) / sizeof(std::uint64_t);
+
+    if (header.count >= available_entries)
+    {
+        throw invalid_archive("index is truncated");
+    }
+
+    auto const entries = static_cast<size_t>(header.count) + 1;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    index = std::span(reinterpret_cast<std::uint64_t const *>(data + sizeof(ArchiveHeader)), entries);
+
+    size_t const chunks_offset = sizeof(ArchiveHeader) + (entries * sizeof(std::uint64_t));
+    auto const chunk_count = static_cast<size_t>(index.back() >> 1);
+
+    if (chunk_count > (size - chunks_offset) / sizeof(ChunkType))
+    {
+        throw invalid_archive("chunks are truncated");
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    chunks = std::span(reinterpret_cast<ChunkType const *>(data + chunks_offset), chunk_count);
+}
+
+void BigIntArchive::write(std::filesystem::path const &path, std::span<BigInt const> values)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+    if (!file)
+    {
+        throw std::system_error(
+            std::make_error_code(std::errc::io_error), std::format("Failed to open \"{}\"", path.string())
+        );
+    }
+
+    auto put = [&file](void const *data, size_t size)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        file.write(reinterpret_cast<char const *>(data), static_cast<std::streamsize>(size));
+    };
+
+    ArchiveHeader const header{archive_magic, archive_byte_order_mark, sizeof(ChunkType), values.size()};
+    put(&header, sizeof(header));
+
+    // The index is written first, so the values are traversed twice instead of buffering the offsets.
+    std::uint64_t offset = 0;
+
+    for (BigIntView const value : values)
+    {
+        std::uint64_t const entry = (offset << 1) | static_cast<std::uint64_t>(value.is_negative());
+        put(&entry, sizeof(entry));
+        offset += value.chunks().size();
+    }
+
+    std::uint64_t const end = offset << 1;
+    put(&end, sizeof(end));
+
+    for (BigIntView const value : values)
+    {
+        put(value.chunks().data(), value.chunks().size_bytes());
+    }
+
+    if (!file.flush())
+    {
+        throw std::system_error(
+            std::make_error_code(std::errc::io_error), std::format("Failed to write \"{}\"", path.string())
+        );
+    }
+}
+
+auto BigIntArchive::at(size_t position) const -> BigIntView
+{
+    if (position >= size())
+    {
+        throw std::out_of_range(std::format("Index {} is out of range for archive of size {}", position, size()));
+    }
+
+    // Entries come from the file, make sure they don't point outside of the chunks.
+    if (index[position] > index[position + 1] || (index[position + 1] >> 1) > chunks.size())
+    {
+        throw std::out_of_range(std::format("Entry {} of the archive index is corrupted", position));
+    }
+
+    return (*this)[position];
+}
@@ -0,0 +1,656 @@
+#include "bigint/async.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <numbers>
+#include <span>
+
+#include "bigint/power_cache.hpp"
+#include "bigint/shared_bigint.hpp"
+#include "combinatorics.hpp"
+#include "radix.hpp"
+
+using namespace BI;
+using namespace BI::detail;
+
+namespace
+{
+using ChunkType = BigInt::ChunkType;
+
+constexpr size_t chunk_bits = sizeof(ChunkType) * 8;
+
+/// @brief Operands up to this many chunks are processed without checking for a stop request.
+constexpr size_t uninterrupted_chunks = 4096;
+
+/// @brief Smallest number of quotient chunks computed between two checks of a division.
+constexpr size_t division_block = 32;
+
+/// @brief The progress is reported once it grew by this much since the last report.
+constexpr double progress_step = 1.0 / 1024;
+
+/// @brief Estimated cost of a multiplication, in chunk multiplications.
+///
+/// Karatsuba multiplies n by n chunks in n^log2(3), and a longer operand in slices of the length of the shorter one.
+auto multiply_cost(double lhs_size, double rhs_size) -> double
+{
+    double const smaller = std::max(std::min(lhs_size, rhs_size), 1.0);
+    double const larger = std::max(std::max(lhs_size, rhs_size), 1.0);
+    return larger * std::pow(smaller, std::log2(3.0) - 1);
+}
+
+/// @brief Estimated cost of a schoolbook division, in chunk multiplications.
+auto divide_cost(double num_size, double denom_size) -> double
+{
+    return std::max(num_size - denom_size + 1, 1.0) * std::max(denom_size, 1.0);
+}
+
+/// @brief Estimated cost of converting a number to a string, in chunk multiplications.
+auto convert_cost(double size) -> double
+{
+    // The conversion divides by powers of the base that span half of the digits, which costs as much at every level.
+    return size * size;
+}
+
+/// @brief Estimated cost of multiplying small factors into a product of the given size by a balanced tree.
+auto tree_cost(double size) -> double
+{
+    double cost = 0;
+
+    for (double count = 1, half = size / 2; half >= 1; count *= 2, half /= 2)
+    {
+        cost += count * multiply_cost(half, half);
+    }
+
+    return cost;
+}
+
+/// @brief Estimated number of chunks of the product of the integers in [first, last), first > 0.
+auto range_size(std::uint64_t first, std::uint64_t last) -> double
+{
+    // lgamma(x) is ln((x - 1)!).
+    double const log = std::lgamma(static_cast<double>(last)) - std::lgamma(static_cast<double>(first));
+    return (log * std::numbers::log2e / chunk_bits) + 1;
+}
+
+/// @brief Give a non-negative result the sign of an operation.
+auto with_sign(BigInt value, bool negative) -> BigInt
+{
+    return negative && !BigIntView(value).is_zero() ? -value : value;
+}
+
+/// @brief Stop request and progress of an asynchronous operation.
+class Task
+{
+public:
+    Task(std::stop_token task_stop, ProgressCallback task_progress)
+        : stop{std::move(task_stop)}, progress{std::move(task_progress)}
+    {
+    }
+
+    /// @brief Set the estimated cost of the whole operation, in the unit passed to advance().
+    void set_cost(double cost) noexcept
+    {
+        total = cost;
+    }
+
+    /// @throws OperationCancelled if a stop was requested.
+    void check() const
+    {
+        if (stop.stop_requested())
+        {
+            throw OperationCancelled();
+        }
+    }
+
+    /// @brief Record the estimated cost of finished work and report the progress if it grew enough.
+    void advance(double cost)
+    {
+        done += cost;
+
+        double const fraction = total > 0 ? std::min(done / total, 1.0) : 0;
+
+        if (progress && fraction < 1 && fraction >= reported + progress_step)
+        {
+            reported = fraction;
+            progress(fraction);
+        }
+    }
+
+    /// @brief Report the end of the operation.
+    void finish() const
+    {
+        if (progress)
+        {
+            progress(1);
+        }
+    }
+
+private:
+    std::stop_token stop;
+    ProgressCallback progress;
+    double total{0};
+    double done{0};
+    double reported{0};
+};
+
+/// @brief Run an operation on its own thread.
+///
+/// @param operation Called with the task of the operation, returns its result.
+template<typename Operation>
+auto launch(std::stop_token stop, ProgressCallback progress, Operation operation)
+{
+    return std::async(
+        std::launch::async,
+        [stop = std::move(stop), progress = std::move(progress), operation = std::move(operation)]() mutable
+        {
+            Task task(std::move(stop), std::move(progress));
+            task.check();
+            auto result = operation(task);
+            task.finish();
+            return result;
+        }
+    );
+}
+
+/// @brief Multiply two numbers, splitting large operands in halves so the stop request is checked between the
+/// products of the halves.
+auto multiply(Task &task, BigIntView lhs, BigIntView rhs) -> BigInt
+{
+    task.check();
+
+    std::span<ChunkType const> larger = lhs.chunks();
+    std::span<ChunkType const> smaller = rhs.chunks();
+
+    if (larger.size() < smaller.size())
+    {
+        std::swap(larger, smaller);
+    }
+
+    if (smaller.size() <= uninterrupted_chunks)
+    {
+        BigInt result = lhs * rhs;
+        task.advance(multiply_cost(static_cast<double>(larger.size()), static_cast<double>(smaller.size())));
+        return result;
+    }
+
+    bool const square = larger.data() == smaller.data() && larger.size() == smaller.size();
+    size_t const half = (larger.size() + 1) / 2;
+    BigIntView const larger_low(larger.first(half));
+    BigIntView const larger_high(larger.subspan(half));
+    BigInt result;
+
+    if (smaller.size() <= half)
+    {
+        // Both halves of the longer operand are multiplied by the whole shorter one.
+        result = multiply(task, larger_high, BigIntView(smaller)) << (half * chunk_bits);
+        result += multiply(task, larger_low, BigIntView(smaller));
+    }
+    else
+    {
+        // Karatsuba: the middle product is (low_1 + high_1)(low_2 + high_2) - low_1 low_2 - high_1 high_2.
+        BigIntView const smaller_low(smaller.first(half));
+        BigIntView const smaller_high(smaller.subspan(half));
+        BigInt const low = multiply(task, larger_low, smaller_low);
+        BigInt const high = multiply(task, larger_high, smaller_high);
+        BigInt const larger_sum = larger_low + larger_high;
+        BigInt middle = square ? multiply(task, larger_sum, larger_sum)
+                               : multiply(task, larger_sum, smaller_low + smaller_high);
+        middle -= low;
+        middle -= high;
+
+        result = high << (2 * half * chunk_bits);
+        result += middle << (half * chunk_bits);
+        result += low;
+    }
+
+    return with_sign(std::move(result), lhs.is_negative() != rhs.is_negative());
+}
+
+/// @brief Divide two numbers a block of quotient chunks at a time, checking the stop request between the blocks.
+auto divide(Task &task, BigIntView num, BigIntView denom) -> std::pair<BigInt, BigInt>
+{
+    task.check();
+
+    std::span<ChunkType const> const num_chunks = num.chunks();
+    std::span<ChunkType const> const denom_chunks = denom.chunks();
+    size_t const quotient_size =
+        num_chunks.size() >= denom_chunks.size() ? num_chunks.size() - denom_chunks.size() + 1 : 0;
+    auto const denom_size = static_cast<double>(denom_chunks.size());
+
+    // A block of the quotient costs about as much as an uninterrupted multiplication.
+    size_t const block = std::max(
+        division_block,
+        static_cast<size_t>(multiply_cost(uninterrupted_chunks, uninterrupted_chunks) / std::max(denom_size, 1.0))
+    );
+
+    if (denom.is_zero() || quotient_size <= block)
+    {
+        auto result = BigInt::div(num, denom);
+        task.advance(divide_cost(static_cast<double>(num_chunks.size()), denom_size));
+        return result;
+    }
+
+    std::vector<ChunkType> quotient(quotient_size);
+    // The chunks above the quotient are smaller than the divisor, they start the remainder.
+    BigInt remainder(BigIntView(num_chunks.subspan(quotient_size)));
+
+    for (size_t end = quotient_size; end > 0;)
+    {
+        task.check();
+
+        size_t const begin = end - std::min(block, end);
+        BigInt const part =
+            (remainder << ((end - begin) * chunk_bits)) + BigIntView(num_chunks.subspan(begin, end - begin));
+        auto [block_quotient, block_remainder] = BigInt::div(part, denom.abs());
+
+        std::ranges::copy(BigIntView(block_quotient).chunks(), quotient.begin() + static_cast<std::ptrdiff_t>(begin));
+        remainder = std::move(block_remainder);
+        task.advance(divide_cost(static_cast<double>(end - begin) + denom_size, denom_size));
+        end = begin;
+    }
+
+    return {
+        BigInt(BigIntView(quotient, num.is_negative() != denom.is_negative())),
+        with_sign(std::move(remainder), num.is_negative())
+    };
+}
+
+/// @brief Raise a number to a power by squaring, from the most significant bit of the power.
+auto raise(Task &task, BigInt const &base, size_t exponent) -> BigInt
+{
+    if (exponent == 0)
+    {
+        return BigInt(1);
+    }
+
+    // Lengths are counted in fractions of chunks, a small base grows the result by a few bits at every step.
+    std::span<ChunkType const> const base_chunks = BigIntView(base).chunks();
+    double const base_size =
+        base_chunks.empty()
+            ? 0
+            : static_cast<double>(base_chunks.size() - 1) +
+                  (std::log2(static_cast<double>(base_chunks.back())) / static_cast<double>(chunk_bits));
+    auto const top_bit = static_cast<size_t>(std::bit_width(exponent)) - 1;
+
+    // The result of every step is about as long as the sum of the lengths of its factors.
+    double cost = 0;
+    double size = base_size;
+
+    for (size_t bit = top_bit; bit-- > 0;)
+    {
+        cost += multiply_cost(size, size);
+        size *= 2;
+
+        if (((exponent >> bit) & 1) != 0)
+        {
+            cost += multiply_cost(size, base_size);
+            size += base_size;
+        }
+    }
+
+    task.set_cost(cost);
+
+    BigInt result = base;
+
+    for (size_t bit = top_bit; bit-- > 0;)
+    {
+        result = multiply(task, result, result);
+
+        if (((exponent >> bit) & 1) != 0)
+        {
+            result = multiply(task, result, base);
+        }
+    }
+
+    return result;
+}
+
+/// @brief Convert a number to a string by splitting it at powers of the base, like BigInt::to_string().
+auto convert(Task &task, BigInt const &num, int base, bool capitalize) -> std::string
+{
+    check_base(base);
+
+    size_t const size = BigIntView(num).chunks().size();
+    auto const base_num = static_cast<ChunkType>(base);
+
+    if (size <= uninterrupted_chunks || std::has_single_bit(base_num))
+    {
+        return num.to_string(base, capitalize);
+    }
+
+    // powers[i] is base^(digits_per_chunk * 2^i), which spans about 2^i chunks, the largest one about half the number.
+    size_t const chunk_digits = radix_table<ChunkType>[base_num].digits_per_chunk;
+    size_t level_count = 1;
+    while ((static_cast<size_t>(1) << level_count) <= size / 2)
+    {
+        ++level_count;
+    }
+
+    auto estimate = [](auto const &self, double value_size, size_t level) -> double
+    {
+        double const power_size = std::ldexp(1.0, static_cast<int>(level) - 1);
+
+        if (level == 0 || value_size <= uninterrupted_chunks)
+        {
+            return convert_cost(value_size);
+        }
+        if (value_size <= power_size)
+        {
+            return self(self, value_size, level - 1);
+        }
+
+        return divide_cost(value_size, power_size) + self(self, value_size - power_size, level - 1) +
+               self(self, power_size, level - 1);
+    };
+
+    // Every power is the square of the previous one, unless it's cached.
+    auto power_cost = [](size_t i)
+    {
+        double const previous_size = std::ldexp(1.0, static_cast<int>(i) - 1);
+        return i == 0 ? 0.0 : multiply_cost(previous_size, previous_size);
+    };
+    double cost = estimate(estimate, static_cast<double>(size), level_count);
+
+    for (size_t i = 0; i < level_count; ++i)
+    {
+        cost += power_cost(i);
+    }
+
+    task.set_cost(cost);
+
+    std::vector<SharedBigInt> powers;
+    powers.reserve(level_count);
+
+    for (size_t i = 0; i < level_count; ++i)
+    {
+        task.check();
+        powers.push_back(cached_power(base_num, chunk_digits << i));
+        task.advance(power_cost(i));
+    }
+
+    std::string result;
+    result.reserve(static_cast<size_t>(static_cast<double>(size * chunk_bits) / std::log2(base)) + 2);
+
+    if (BigIntView(num).is_negative())
+    {
+        result += '-';
+    }
+
+    // Every part except the first one is padded with zeroes to the exact number of digits it spans.
+    auto write = [&](auto const &self, BigInt const &value, size_t level, size_t width) -> void
+    {
+        task.check();
+
+        if (width == 0)
+        {
+            while (level > 0 && BigIntView(powers[level - 1]) > BigIntView(value))
+            {
+                --level;
+            }
+        }
+
+        auto const value_size = static_cast<double>(BigIntView(value).chunks().size());
+
+        if (level == 0 || value_size <= uninterrupted_chunks)
+        {
+            std::string const digits = value.to_string(base, capitalize);
+            result.append(width > digits.size() ? width - digits.size() : 0, '0');
+            result += digits;
+            task.advance(convert_cost(value_size));
+            return;
+        }
+
+        auto const [high, low] = divide(task, value, powers[level - 1]);
+        size_t const low_width = chunk_digits << (level - 1);
+
+        self(self, high, level - 1, width == 0 ? 0 : width - low_width);
+        self(self, low, level - 1, low_width);
+    };
+
+    write(write, num.abs(), level_count, 0);
+    return result;
+}
+
+/// @brief Estimated cost of tree_product() for numbers of the given sizes.
+auto tree_product_cost(std::vector<double> sizes) -> double
+{
+    double cost = 0;
+
+    while (sizes.size() > 1)
+    {
+        std::vector<double> next;
+        next.reserve((sizes.size() + 1) / 2);
+
+        for (size_t i = 0; i + 1 < sizes.size(); i += 2)
+        {
+            cost += multiply_cost(sizes[i], sizes[i + 1]);
+            next.push_back(sizes[i] + sizes[i + 1]);
+        }
+        if (sizes.size() % 2 == 1)
+        {
+            next.push_back(sizes.back());
+        }
+
+        sizes = std::move(next);
+    }
+
+    return cost;
+}
+
+/// @brief Multiply numbers by multiplying neighbours until a single number is left.
+auto tree_product(Task &task, std::vector<BigInt> level) -> BigInt
+{
+    if (level.empty())
+    {
+        return BigInt(1);
+    }
+
+    while (level.size() > 1)
+    {
+        std::vector<BigInt> next;
+        next.reserve((level.size() + 1) / 2);
+
+        for (size_t i = 0; i + 1 < level.size(); i += 2)
+        {
+            next.push_back(multiply(task, level[i], level[i + 1]));
+        }
+        if (level.size() % 2 == 1)
+        {
+            next.push_back(std::move(level.back()));
+        }
+
+        level = std::move(next);
+    }
+
+    return std::move(level.front());
+}
+
+/// @brief Multiply small factors by product trees of uninterrupted size, whose results are then multiplied together.
+auto factor_product(Task &task, std::span<std::uint64_t const> factors) -> BigInt
+{
+    std::vector<BigInt> groups;
+
+    // Every factor fits in a chunk.
+    for (size_t i = 0; i < factors.size(); i += uninterrupted_chunks)
+    {
+        task.check();
+
+        std::span<std::uint64_t const> const group =
+            factors.subspan(i, std::min(uninterrupted_chunks, factors.size() - i));
+        groups.push_back(product_tree(group));
+        task.advance(tree_cost(static_cast<double>(group.size())));
+    }
+
+    return tree_product(task, std::move(groups));
+}
+
+/// @brief Estimated cost of range_product().
+auto range_product_cost(std::uint64_t first, std::uint64_t last) -> double
+{
+    double const size = range_size(first, last);
+
+    if (size <= uninterrupted_chunks)
+    {
+        return tree_cost(size);
+    }
+
+    std::uint64_t const middle = first + ((last - first) / 2);
+    return range_product_cost(first, middle) + range_product_cost(middle, last) +
+           multiply_cost(range_size(first, middle), range_size(middle, last));
+}
+
+/// @brief Multiply the integers in [first, last), first > 0, by binary splitting down to ranges of uninterrupted size.
+auto range_product(Task &task, std::uint64_t first, std::uint64_t last) -> BigInt
+{
+    task.check();
+
+    double const size = range_size(first, last);
+
+    if (size <= uninterrupted_chunks)
+    {
+        BigInt result = product(first, last);
+        task.advance(tree_cost(size));
+        return result;
+    }
+
+    std::uint64_t const middle = first + ((last - first) / 2);
+    BigInt const low = range_product(task, first, middle);
+    BigInt const high = range_product(task, middle, last);
+    return multiply(task, low, high);
+}
+
+/// @brief Estimated cost of swing_factorial().
+auto swing_factorial_cost(std::uint64_t n) -> double
+{
+    if (n < small_factorials.size())
+    {
+        return 0;
+    }
+
+    // The swinging factorial of n is about the central binomial coefficient, which is close to 2^n.
+    double const half_size = range_size(1, (n / 2) + 1);
+    double const swing_size = (static_cast<double>(n) / chunk_bits) + 1;
+    return swing_factorial_cost(n / 2) + multiply_cost(half_size, half_size) + tree_cost(swing_size) +
+           multiply_cost(2 * half_size, swing_size);
+}
+
+/// @brief Get n! as (floor(n / 2)!)^2 times the swinging factorial of n, like factorial().
+auto swing_factorial(Task &task, std::uint64_t n, std::span<std::uint64_t const> primes) -> BigInt
+{
+    task.check();
+
+    if (n < small_factorials.size())
+    {
+        return BigInt(small_factorials[n]);
+    }
+
+    BigInt const half = swing_factorial(task, n / 2, primes);
+    BigInt const square = multiply(task, half, half);
+    return multiply(task, square, factor_product(task, swing_factors(n, primes)));
+}
+}  // namespace
+
+namespace BI
+{
+auto pow_async(BigInt base, size_t power, std::stop_token stop, ProgressCallback progress) -> std::future<BigInt>
+{
+    return launch(
+        std::move(stop),
+        std::move(progress),
+        [base = std::move(base), power](Task &task) { return raise(task, base, power); }
+    );
+}
+
+auto div_async(BigInt num, BigInt denom, std::stop_token stop, ProgressCallback progress)
+    -> std::future<std::pair<BigInt, BigInt>>
+{
+    return launch(
+        std::move(stop),
+        std::move(progress),
+        [num = std::move(num), denom = std::move(denom)](Task &task)
+        {
+            std::span<ChunkType const> const num_chunks = BigIntView(num).chunks();
+            std::span<ChunkType const> const denom_chunks = BigIntView(denom).chunks();
+            task.set_cost(
+                divide_cost(static_cast<double>(num_chunks.size()), static_cast<double>(denom_chunks.size()))
+            );
+            return divide(task, num, denom);
+        }
+    );
+}
+
+auto to_string_async(BigInt num, int base, bool capitalize, std::stop_token stop, ProgressCallback progress)
+    -> std::future<std::string>
+{
+    return launch(
+        std::move(stop),
+        std::move(progress),
+        [num = std::move(num), base, capitalize](Task &task) { return convert(task, num, base, capitalize); }
+    );
+}
+
+auto product_async(std::uint64_t first, std::uint64_t last, std::stop_token stop, ProgressCallback progress)
+    -> std::future<BigInt>
+{
+    return launch(
+        std::move(stop),
+        std::move(progress),
+        [first, last](Task &task)
+        {
+            if (first >= last)
+            {
+                return BigInt(1);
+            }
+            if (first == 0)
+            {
+                return BigInt();
+            }
+
+            task.set_cost(range_product_cost(first, last));
+            return range_product(task, first, last);
+        }
+    );
+}
+
+auto factorial_async(std::uint64_t n, std::stop_token stop, ProgressCallback progress) -> std::future<BigInt>
+{
+    return launch(
+        std::move(stop),
+        std::move(progress),
+        [n](Task &task)
+        {
+            if (n < small_factorials.size())
+            {
+                return BigInt(small_factorials[n]);
+            }
+
+            task.set_cost(swing_factorial_cost(n));
+            std::vector<std::uint64_t> const primes = primes_up_to(n);
+            return swing_factorial(task, n, primes);
+        }
+    );
+}
+
+auto reduce_product_async(std::vector<BigInt> values, std::stop_token stop, ProgressCallback progress)
+    -> std::future<BigInt>
+{
+    return launch(
+        std::move(stop),
+        std::move(progress),
+        [values = std::move(values)](Task &task) mutable
+        {
+            std::vector<double> sizes;
+            sizes.reserve(values.size());
+
+            for (BigInt const &value : values)
+            {
+                sizes.push_back(static_cast<double>(BigIntView(value).chunks().size()));
+            }
+
+            task.set_cost(tree_product_cost(std::move(sizes)));
+            return tree_product(task, std::move(values));
+        }
+    );
+}
+}  // namespace BI
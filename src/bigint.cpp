@@ -1,18 +1,98 @@
 #include "bigint/bigint.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <cstdint>
+#include <tuple>
 #include <utility>
+#include <vector>
 #ifdef _MSC_VER
 #   include <intrin.h>
 #endif
 
+#include "thread_pool.hpp"
+
 using namespace BI;
 using namespace BI::detail;
 
-// Avoid having to convert the number to a BigInt over and over again.
-static auto const one = BigInt(1);
+namespace
+{
+using ChunkType = BigInt::ChunkType;
+
+/// @brief Chunks of 1, viewed by one so it is never converted to a BigInt at runtime.
+constexpr std::array<ChunkType, 1> one_chunks{1};
+constexpr BigIntView one(one_chunks);
+
+/// @brief Operands with fewer chunks than this are multiplied with schoolbook multiplication.
+constexpr size_t karatsuba_threshold = 32;
+
+/// @brief Add a magnitude to another one in place.
+///
+/// @param[in,out] target The magnitude to add to.
+/// @param addend The magnitude to add, must not be longer than target.
+/// @return The carry out of the most significant chunk of target.
+auto add_in_place(std::span<ChunkType> target, std::span<ChunkType const> addend) noexcept -> ChunkType
+{
+    assert(addend.size() <= target.size());
+
+    ChunkType carry = 0;
+
+    for (size_t i = 0; i < addend.size(); ++i)
+    {
+        ChunkType const sum = target[i] + addend[i];
+        ChunkType const overflow = static_cast<ChunkType>(sum < addend[i]);
+        target[i] = sum + carry;
+        carry = overflow | static_cast<ChunkType>(target[i] < carry);
+    }
+
+    for (size_t i = addend.size(); carry != 0 && i < target.size(); ++i)
+    {
+        carry = static_cast<ChunkType>(++target[i] == 0);
+    }
+
+    return carry;
+}
+
+/// @brief Subtract a magnitude from another one in place.
+///
+/// @param[in,out] target The magnitude to subtract from.
+/// @param subtrahend The magnitude to subtract, must not be longer than target.
+/// @return The borrow out of the most significant chunk of target.
+auto subtract_in_place(std::span<ChunkType> target, std::span<ChunkType const> subtrahend) noexcept -> ChunkType
+{
+    assert(subtrahend.size() <= target.size());
+
+    ChunkType borrow = 0;
+
+    for (size_t i = 0; i < subtrahend.size(); ++i)
+    {
+        ChunkType const difference = target[i] - subtrahend[i];
+        ChunkType const underflow = static_cast<ChunkType>(target[i] < subtrahend[i]);
+        target[i] = difference - borrow;
+        borrow = underflow | static_cast<ChunkType>(difference < borrow);
+    }
+
+    for (size_t i = subtrahend.size(); borrow != 0 && i < target.size(); ++i)
+    {
+        borrow = static_cast<ChunkType>(target[i]-- == 0);
+    }
+
+    return borrow;
+}
+
+/// @brief Get a magnitude without its leading zero chunks.
+auto trimmed(std::span<ChunkType const> chunks) noexcept -> std::span<ChunkType const>
+{
+    while (!chunks.empty() && chunks.back() == 0)
+    {
+        chunks = chunks.first(chunks.size() - 1);
+    }
+
+    return chunks;
+}
+}  // namespace
 
 BigInt::BigInt()
 {
@@ -70,80 +150,66 @@ BigInt::BigInt(std::string_view num)
     remove_leading_zeroes();
 }
 
-auto BigInt::operator+() const noexcept -> BigInt
+BigInt::BigInt(std::string_view num, int base)
 {
-    return *this;
-}
-
-auto BigInt::operator-() const noexcept -> BigInt
-{
-    BigInt result{*this};
-    result.negative = !result.negative;
-    return result;
-}
-
-auto BigInt::operator+(BigInt const &rhs) const noexcept -> BigInt
-{
-    if (is_zero())
-    {
-        return rhs;
-    }
+    Base const num_base = to_base(base);
+    negative = !num.empty() && num[0] == '-';
+    std::string_view const digits = num.substr(negative ? 1 : 0);
 
-    if (rhs.is_zero())
+    if (digits.empty())
     {
-        return *this;
+        throw std::invalid_argument(std::format("Invalid number: \"{}\"", num));
     }
 
-    bool magnitude_greater = compare_magnitude(rhs) == std::strong_ordering::greater;
-    BigInt result;
-
-    if (negative == rhs.negative)
+    try
     {
-        result = magnitude_greater ? add_magnitude(rhs) : rhs.add_magnitude(*this);
+        base_to_binary(digits, num_base);
     }
-    else
+    catch (std::invalid_argument const &e)
     {
-        result = magnitude_greater ? subtract_magnitude(rhs) : rhs.subtract_magnitude(*this);
+        throw std::invalid_argument(std::format("Invalid number in base {}: \"{}\"", base, num));
     }
 
-    result.negative = magnitude_greater ? negative : rhs.negative;
-    return result;
+    // Remove leading zeroes.
+    remove_leading_zeroes();
 }
 
-auto BigInt::operator-(BigInt const &rhs) const noexcept -> BigInt
+BigInt::BigInt(BigIntView num) : negative{num.is_negative()}
 {
-    if (is_zero())
-    {
-        return -rhs;
-    }
-
-    if (rhs.is_zero())
-    {
-        return *this;
-    }
-
-    bool magnitude_greater = compare_magnitude(rhs) == std::strong_ordering::greater;
-    BigInt result;
-
-    if (negative == rhs.negative)
+    if (num.is_zero())
     {
-        result = magnitude_greater ? subtract_magnitude(rhs) : rhs.subtract_magnitude(*this);
+        chunks.push_back(0);
     }
     else
     {
-        result = magnitude_greater ? add_magnitude(rhs) : rhs.add_magnitude(*this);
+        chunks.assign(num.chunks().begin(), num.chunks().end());
     }
+}
 
-    result.negative = magnitude_greater ? negative : !rhs.negative;
+auto BigInt::operator+() const noexcept -> BigInt
+{
+    return *this;
+}
+
+auto BigInt::operator-() const noexcept -> BigInt
+{
+    BigInt result{*this};
+    result.negative = !result.negative;
     return result;
 }
 
+auto BigInt::operator+(BigInt const &rhs) const noexcept -> BigInt
+{
+    return BigIntView(*this) + BigIntView(rhs);
+}
+
+auto BigInt::operator-(BigInt const &rhs) const noexcept -> BigInt
+{
+    return BigIntView(*this) - BigIntView(rhs);
+}
+
 auto BigInt::operator*(BigInt const &rhs) const noexcept -> BigInt
 {
-    if (is_zero() || rhs.is_zero())
-    {
-        return BigInt{};
-    }
     if (*this == one)
     {
         return rhs;
@@ -153,45 +219,7 @@ auto BigInt::operator*(BigInt const &rhs) const noexcept -> BigInt
         return *this;
     }
 
-    bool const magnitude_greater = compare_magnitude(rhs) == std::strong_ordering::greater;
-    BigInt const &larger = magnitude_greater ? *this : rhs;
-    BigInt const &smaller = magnitude_greater ? rhs : *this;
-
-    BigInt result{};
-    // Reserve enough space for the result.
-    // log(a * b) = log(a) + log(b).
-    result.chunks.reserve(larger.chunks.size() + smaller.chunks.size());
-
-    // Temporary result of multiplying the larger number by a single chunk of smaller number shifted to the left.
-    BigInt temp{};
-    temp.chunks.reserve(larger.chunks.size() + smaller.chunks.size());
-
-    // Use grade school multiplication to multiply the numbers.
-    // TODO(famiu): Use Karatsuba multiplication for large numbers.
-    for (size_t i = 0; i < smaller.chunks.size(); ++i)
-    {
-        temp.chunks.clear();
-
-        ChunkType carry = 0;
-        for (ChunkType chunk : larger.chunks)
-        {
-            auto const [low, high] = multiply_chunks(chunk, smaller.chunks[i]);
-            temp.chunks.push_back(low + carry);
-            carry = high + static_cast<ChunkType>(low > chunk_max - carry);
-        }
-
-        if (carry != 0)
-        {
-            temp.chunks.push_back(carry);
-        }
-
-        temp.chunks.insert(temp.chunks.begin(), i, 0);
-        result += temp;
-    }
-
-    result.negative = negative != rhs.negative;
-
-    return result;
+    return BigIntView(*this) * BigIntView(rhs);
 }
 
 auto BigInt::operator/(BigInt const &rhs) const -> BigInt
@@ -332,43 +360,33 @@ auto BigInt::operator>>=(size_t rhs) noexcept -> BigInt &
 
 auto BigInt::operator++() noexcept -> BigInt &
 {
-    *this += one;
+    *this = *this + one;
     return *this;
 }
 
 auto BigInt::operator--() noexcept -> BigInt &
 {
-    *this -= one;
+    *this = *this - one;
     return *this;
 }
 
 auto BigInt::operator++(int) noexcept -> BigInt
 {
     BigInt result{*this};
-    *this += one;
+    *this = *this + one;
     return result;
 }
 
 auto BigInt::operator--(int) noexcept -> BigInt
 {
     BigInt result{*this};
-    *this -= one;
+    *this = *this - one;
     return result;
 }
 
 auto BigInt::operator<=>(BigInt const &rhs) const noexcept -> std::strong_ordering
 {
-    if (this->is_zero() && rhs.is_zero())
-    {
-        return std::strong_ordering::equal;
-    }
-
-    if (negative != rhs.negative)
-    {
-        return negative ? std::strong_ordering::less : std::strong_ordering::greater;
-    }
-
-    return negative ? rhs.compare_magnitude(*this) : compare_magnitude(rhs);
+    return BigIntView(*this) <=> BigIntView(rhs);
 }
 
 auto BigInt::operator==(BigInt const &rhs) const noexcept -> bool
@@ -378,7 +396,12 @@ auto BigInt::operator==(BigInt const &rhs) const noexcept -> bool
 
 BigInt::operator std::string() const
 {
-    return format_to_base(Base::Decimal);
+    return format_to_base(*this, Base::Decimal);
+}
+
+auto BigInt::to_string(int base, bool capitalize) const -> std::string
+{
+    return format_to_base(*this, to_base(base), false, capitalize);
 }
 
 auto BigInt::abs() const noexcept -> BigInt
@@ -388,17 +411,7 @@ auto BigInt::abs() const noexcept -> BigInt
     return result;
 }
 
-auto operator<<(std::ostream &os, BigInt const &num) -> std::ostream &
-{
-    return os << static_cast<std::string>(num);
-}
-
-auto operator""_bi(char const *num) -> BigInt
-{
-    return BigInt{num};
-}
-
-auto BigInt::div(BigInt const &num, BigInt const &denom) -> std::pair<BigInt, BigInt>
+auto BigInt::div(BigIntView num, BigIntView denom) -> std::pair<BigInt, BigInt>
 {
     if (denom.is_zero())
     {
@@ -410,47 +423,18 @@ auto BigInt::div(BigInt const &num, BigInt const &denom) -> std::pair<BigInt, Bi
         return {BigInt{}, BigInt{}};
     }
 
-    if (num.compare_magnitude(denom) == std::strong_ordering::less)
+    if (compare_magnitude(num.chunks(), denom.chunks()) == std::strong_ordering::less)
     {
-        return {BigInt{}, num};
+        return {BigInt{}, BigInt(num)};
     }
 
     BigInt quotient{};
-    BigInt remainder{num.abs()};
-    // Reserve enough space for the quotient.
-    // log(a / b) = log(a) - log(b).
-    quotient.chunks.reserve(num.chunks.size() - denom.chunks.size() + 1);
-
-    // Perform long division:
-    // 1. Find the largest multiple of the denominator that fits in the current remainder.
-    // 2. Subtract the multiple from the remainder.
-    // 3. Repeat until the remainder is less than the denominator.
-    while (remainder.compare_magnitude(denom) != std::strong_ordering::less)
-    {
-        BigInt temp{denom.abs()};
-        // Approximate the amount of shifts needed to align the most significant bit of the denominator with the
-        // most significant bit of the remainder.
-        size_t shift = remainder.bit_count() - temp.bit_count();
-
-        // Align the most significant bit of the denominator with the most significant bit of the remainder.
-        temp <<= shift;
-
-        // If the denominator is still greater than the remainder, shift it to the right once.
-        // This will guarantee that the denominator is less than the remainder.
-        if (temp.compare_magnitude(remainder) == std::strong_ordering::greater)
-        {
-            temp >>= 1;
-            --shift;
-        }
-
-        // Subtract the multiple from the remainder, and add the multiplier to the quotient.
-        remainder -= temp;
-        quotient += one << shift;
-    }
+    BigInt remainder{};
+    divide_magnitude(num.chunks(), denom.chunks(), quotient.chunks, remainder.chunks);
 
     // For remainder, the sign is always the same as the dividend.
-    remainder.negative = num.negative;
-    quotient.negative = num.negative != denom.negative;
+    remainder.negative = num.is_negative();
+    quotient.negative = num.is_negative() != denom.is_negative();
 
     return {quotient, remainder};
 }
@@ -461,7 +445,7 @@ auto BigInt::pow(size_t power) const noexcept -> BigInt
     // NOTE: 0^0 also returns 1.
     if (power == 0)
     {
-        return one;
+        return BigInt(one);
     }
 
     // x^1 = x
@@ -478,9 +462,6 @@ auto BigInt::pow(size_t power) const noexcept -> BigInt
     auto const power_bit_count = (sizeof(size_t) * 8) - power_leading_zeroes;
 
     BigInt result(1);
-    // Reserve enough space for the result.
-    // log(a ^ b) = b * log(a).
-    result.chunks.reserve(chunks.size() * power);
 
     // Get rid of leading zeroes so that we can iterate through the bits of the power.
     power <<= power_leading_zeroes;
@@ -531,49 +512,55 @@ void BigInt::remove_leading_zeroes()
 
 auto BigInt::compare_magnitude(BigInt const &rhs) const noexcept -> std::strong_ordering
 {
-    if (chunks.size() != rhs.chunks.size())
+    return compare_magnitude(BigIntView(*this).chunks(), BigIntView(rhs).chunks());
+}
+
+auto BigInt::compare_magnitude(std::span<ChunkType const> lhs, std::span<ChunkType const> rhs) noexcept
+    -> std::strong_ordering
+{
+    if (lhs.size() != rhs.size())
     {
-        return chunks.size() <=> rhs.chunks.size();
+        return lhs.size() <=> rhs.size();
     }
 
-    for (size_t i = chunks.size(); i-- > 0;)
+    for (size_t i = lhs.size(); i-- > 0;)
     {
-        if (chunks[i] != rhs.chunks[i])
+        if (lhs[i] != rhs[i])
         {
-            return chunks[i] <=> rhs.chunks[i];
+            return lhs[i] <=> rhs[i];
         }
     }
 
     return std::strong_ordering::equal;
 }
 
-auto BigInt::add_magnitude(BigInt const &rhs) const noexcept -> BigInt
+auto BigInt::add_magnitude(std::span<ChunkType const> lhs, std::span<ChunkType const> rhs) -> BigInt
 {
-    assert(compare_magnitude(rhs) != std::strong_ordering::less);
+    assert(lhs.size() >= rhs.size());
 
-    BigInt result{*this};
+    if (lhs.empty())
+    {
+        return BigInt{};
+    }
+
+    BigInt result;
+    result.chunks.reserve(lhs.size() + 1);
+    result.chunks.assign(lhs.begin(), lhs.end());
     ChunkType carry = 0;
 
-    for (size_t i = 0; i < rhs.chunks.size(); ++i)
+    for (size_t i = 0; i < rhs.size(); ++i)
     {
-        // Check if the current chunk can be added to without overflow.
-        if (result.chunks[i] < chunk_max - rhs.chunks[i] - carry)
-        {
-            result.chunks[i] += rhs.chunks[i] + carry;
-            carry = 0;
-        }
-        else
-        {
-            // Add with overflow and carry to next chunk.
-            result.chunks[i] += rhs.chunks[i] + carry;
-            carry = 1;
-        }
+        // Add the chunks and the carry, the addition overflowed if the sum is smaller than one of its parts.
+        ChunkType const sum = result.chunks[i] + rhs[i];
+        ChunkType const overflow = static_cast<ChunkType>(sum < rhs[i]);
+        result.chunks[i] = sum + carry;
+        carry = overflow | static_cast<ChunkType>(result.chunks[i] < carry);
     }
 
     // Add carry to the rest of the number.
     if (carry != 0)
     {
-        for (size_t i = rhs.chunks.size(); i < result.chunks.size(); ++i)
+        for (size_t i = rhs.size(); i < result.chunks.size(); ++i)
         {
             if (result.chunks[i] == chunk_max)
             {
@@ -597,33 +584,32 @@ auto BigInt::add_magnitude(BigInt const &rhs) const noexcept -> BigInt
     return result;
 }
 
-auto BigInt::subtract_magnitude(BigInt const &rhs) const noexcept -> BigInt
+auto BigInt::subtract_magnitude(std::span<ChunkType const> lhs, std::span<ChunkType const> rhs) -> BigInt
 {
-    assert(compare_magnitude(rhs) != std::strong_ordering::less);
+    assert(compare_magnitude(lhs, rhs) != std::strong_ordering::less);
 
-    BigInt result{*this};
+    if (lhs.empty())
+    {
+        return BigInt{};
+    }
+
+    BigInt result;
+    result.chunks.assign(lhs.begin(), lhs.end());
     ChunkType borrow = 0;
 
-    for (size_t i = 0; i < rhs.chunks.size(); ++i)
+    for (size_t i = 0; i < rhs.size(); ++i)
     {
-        // Check if the current chunk can be subtracted from without underflow.
-        if (result.chunks[i] >= rhs.chunks[i] + borrow)
-        {
-            result.chunks[i] -= rhs.chunks[i] + borrow;
-            borrow = 0;
-        }
-        else
-        {
-            // Subtract with underflow and borrow from next chunk.
-            result.chunks[i] -= rhs.chunks[i] + borrow;
-            borrow = 1;
-        }
+        // Subtract the chunk and the borrow, borrow from the next chunk if either subtraction underflowed.
+        ChunkType const difference = result.chunks[i] - rhs[i];
+        ChunkType const underflow = static_cast<ChunkType>(result.chunks[i] < rhs[i]);
+        result.chunks[i] = difference - borrow;
+        borrow = underflow | static_cast<ChunkType>(difference < borrow);
     }
 
     // Subtract borrow from the rest of the number.
     if (borrow != 0)
     {
-        for (size_t i = rhs.chunks.size(); i < result.chunks.size(); ++i)
+        for (size_t i = rhs.size(); i < result.chunks.size(); ++i)
         {
             if (result.chunks[i] == 0)
             {
@@ -694,3 +680,323 @@ auto BigInt::multiply_chunks(ChunkType const a, ChunkType const b) noexcept -> s
 #endif
     }
 }
+
+/// @details Uses 128-bit division when available for 64-bit chunks. Otherwise, the quotient is computed one bit at a
+/// time with shift-and-subtract, which is slow but works for any chunk size.
+auto BigInt::divide_chunks(ChunkType const high, ChunkType const low, ChunkType const divisor) noexcept
+    -> std::pair<ChunkType, ChunkType>
+{
+    assert(divisor != 0 && high < divisor);
+
+    if constexpr (sizeof(ChunkType) <= 4)
+    {
+        auto const dividend = (static_cast<uint64_t>(high) << chunk_bits) | low;
+        return {static_cast<ChunkType>(dividend / divisor), static_cast<ChunkType>(dividend % divisor)};
+    }
+    else
+    {
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__SIZEOF_INT128__)
+        auto const dividend = (static_cast<__uint128_t>(high) << 64) | low;
+        return {static_cast<ChunkType>(dividend / divisor), static_cast<ChunkType>(dividend % divisor)};
+#else
+        ChunkType quotient = 0;
+        ChunkType remainder = high;
+
+        for (size_t i = chunk_bits; i-- > 0;)
+        {
+            // The remainder can temporarily need one extra bit, track it separately.
+            bool const overflow = (remainder >> (chunk_bits - 1)) != 0;
+            remainder = (remainder << 1) | ((low >> i) & 1);
+            quotient <<= 1;
+
+            if (overflow || remainder >= divisor)
+            {
+                remainder -= divisor;
+                quotient |= 1;
+            }
+        }
+
+        return {quotient, remainder};
+#endif
+    }
+}
+
+auto BigInt::divide_by_chunk(std::span<ChunkType> num, ChunkType const divisor) noexcept -> ChunkType
+{
+    ChunkType remainder = 0;
+
+    // Schoolbook division from the most significant chunk, the remainder carries into the next chunk.
+    for (size_t i = num.size(); i-- > 0;)
+    {
+        std::tie(num[i], remainder) = divide_chunks(remainder, num[i], divisor);
+    }
+
+    return remainder;
+}
+
+void BigInt::multiply_schoolbook(
+    std::span<ChunkType const> lhs,
+    std::span<ChunkType const> rhs,
+    std::span<ChunkType> result
+) noexcept
+{
+    assert(result.size() == lhs.size() + rhs.size());
+
+    std::ranges::fill(result, 0);
+
+    // Multiply lhs by every chunk of rhs and accumulate the row into the result in place.
+    // lhs[j] * rhs[i] + result[i + j] + carry always fits in two chunks, so no extra carry is ever needed.
+    for (size_t i = 0; i < rhs.size(); ++i)
+    {
+        ChunkType carry = 0;
+
+        for (size_t j = 0; j < lhs.size(); ++j)
+        {
+            auto [low, high] = multiply_chunks(lhs[j], rhs[i]);
+            low += carry;
+            high += static_cast<ChunkType>(low < carry);
+            result[i + j] += low;
+            high += static_cast<ChunkType>(result[i + j] < low);
+            carry = high;
+        }
+
+        result[i + lhs.size()] = carry;
+    }
+}
+
+/// @details With lhs = a1 * B^m + a0 and rhs = b1 * B^m + b0, the product is z2 * B^2m + z1 * B^m + z0 where
+/// z0 = a0 * b0, z2 = a1 * b1 and z1 = (a0 + a1) * (b0 + b1) - z0 - z2. z0 and z2 are written straight into their
+/// places in the result, which don't overlap, and z1 is added on top.
+void BigInt::multiply_magnitude(
+    std::span<ChunkType const> lhs,
+    std::span<ChunkType const> rhs,
+    std::span<ChunkType> result,
+    ExecutionPolicy const &policy
+)
+{
+    assert(result.size() == lhs.size() + rhs.size());
+
+    if (lhs.size() < rhs.size())
+    {
+        std::swap(lhs, rhs);
+    }
+
+    if (rhs.size() < karatsuba_threshold)
+    {
+        multiply_schoolbook(lhs, rhs, result);
+        return;
+    }
+
+    size_t const n = rhs.size();
+
+    if (lhs.size() >= 2 * n)
+    {
+        // Multiply rhs by blocks of lhs of its own size, each product overlaps the next one by n chunks.
+        std::ranges::fill(result, 0);
+        std::vector<ChunkType> block_product(2 * n);
+
+        for (size_t offset = 0; offset < lhs.size(); offset += n)
+        {
+            std::span<ChunkType const> const block = lhs.subspan(offset, std::min(n, lhs.size() - offset));
+            std::span<ChunkType> const product = std::span(block_product).first(block.size() + n);
+
+            multiply_magnitude(block, rhs, product, policy);
+            [[maybe_unused]] ChunkType const carry = add_in_place(result.subspan(offset), product);
+            assert(carry == 0);
+        }
+
+        return;
+    }
+
+    // lhs has fewer than 2n chunks, so both high halves are non-empty.
+    size_t const m = lhs.size() / 2;
+    std::span<ChunkType const> const a0 = lhs.first(m);
+    std::span<ChunkType const> const a1 = lhs.subspan(m);
+    std::span<ChunkType const> const b0 = rhs.first(m);
+    std::span<ChunkType const> const b1 = rhs.subspan(m);
+
+    auto sum = [](std::span<ChunkType const> low, std::span<ChunkType const> high)
+    {
+        // high is at least as long as low.
+        std::vector<ChunkType> chunks(high.size() + 1, 0);
+        std::ranges::copy(high, chunks.begin());
+        chunks.back() = add_in_place(std::span(chunks).first(high.size()), low);
+        return chunks;
+    };
+
+    std::vector<ChunkType> const a_sum = sum(a0, a1);
+    std::vector<ChunkType> const b_sum = b1.size() >= m ? sum(b0, b1) : sum(b1, b0);
+    std::vector<ChunkType> middle(a_sum.size() + b_sum.size());
+
+    std::span<ChunkType> const z0 = result.first(2 * m);
+    std::span<ChunkType> const z2 = result.subspan(2 * m);
+
+    auto low_product = [&] { multiply_magnitude(a0, b0, z0, policy); };
+    auto high_product = [&] { multiply_magnitude(a1, b1, z2, policy); };
+    auto middle_product = [&] { multiply_magnitude(a_sum, b_sum, middle, policy); };
+
+    if (policy.is_parallel(n))
+    {
+        detail::ThreadPool::get(policy.threads).invoke(policy.threads, middle_product, high_product, low_product);
+    }
+    else
+    {
+        low_product();
+        high_product();
+        middle_product();
+    }
+
+    // (a0 + a1) * (b0 + b1) >= z0 + z2, and the difference is smaller than the result.
+    [[maybe_unused]] ChunkType borrow = subtract_in_place(middle, z0);
+    borrow |= subtract_in_place(middle, z2);
+    assert(borrow == 0);
+
+    [[maybe_unused]] ChunkType const carry = add_in_place(result.subspan(m), trimmed(middle));
+    assert(carry == 0);
+}
+
+/// @details See Knuth, The Art of Computer Programming, Vol. 2, Section 4.3.1. Both numbers are normalized by
+/// shifting them left until the most significant bit of the divisor is set, which makes every estimated quotient chunk
+/// at most 2 larger than the real one.
+void BigInt::divide_magnitude(
+    std::span<ChunkType const> num,
+    std::span<ChunkType const> denom,
+    DataType &quotient,
+    DataType &remainder
+)
+{
+    assert(!denom.empty() && denom.back() != 0);
+
+    auto trim = [](DataType &data)
+    {
+        while (data.size() > 1 && data.back() == 0)
+        {
+            data.pop_back();
+        }
+    };
+
+    if (num.size() < denom.size())
+    {
+        quotient.assign(1, 0);
+        remainder.assign(num.begin(), num.end());
+        trim(remainder);
+        return;
+    }
+
+    // Single chunk divisors don't need the quotient estimation.
+    if (denom.size() == 1)
+    {
+        quotient.assign(num.begin(), num.end());
+        remainder.assign(1, divide_by_chunk(quotient, denom[0]));
+        trim(quotient);
+        return;
+    }
+
+    size_t const n = denom.size();
+    size_t const m = num.size() - n;
+    auto const shift = static_cast<size_t>(std::countl_zero(denom.back()));
+
+    // Shift two chunks into one, used to normalize the numbers.
+    auto shift_in = [shift](ChunkType high, ChunkType low) -> ChunkType
+    {
+        return shift == 0 ? high : (high << shift) | (low >> (chunk_bits - shift));
+    };
+
+    DataType v(n);
+    DataType u(num.size() + 1);
+
+    for (size_t i = n; i-- > 0;)
+    {
+        v[i] = shift_in(denom[i], i > 0 ? denom[i - 1] : 0);
+    }
+
+    u[num.size()] = shift_in(0, num.back());
+    for (size_t i = num.size(); i-- > 0;)
+    {
+        u[i] = shift_in(num[i], i > 0 ? num[i - 1] : 0);
+    }
+
+    quotient.assign(m + 1, 0);
+
+    for (size_t j = m + 1; j-- > 0;)
+    {
+        // Estimate the quotient chunk from the top two chunks of the remainder and the top chunk of the divisor.
+        ChunkType q_hat = chunk_max;
+        ChunkType r_hat = 0;
+        bool r_hat_overflow = false;
+
+        if (u[j + n] < v[n - 1])
+        {
+            std::tie(q_hat, r_hat) = divide_chunks(u[j + n], u[j + n - 1], v[n - 1]);
+        }
+        else
+        {
+            // q_hat = chunk_max, r_hat = u[j + n] * base + u[j + n - 1] - q_hat * v[n - 1].
+            r_hat = u[j + n - 1] + v[n - 1];
+            r_hat_overflow = r_hat < v[n - 1];
+        }
+
+        // Refine the estimate with the second chunk of the divisor, this makes it at most 1 too large.
+        while (!r_hat_overflow)
+        {
+            auto const [low, high] = multiply_chunks(q_hat, v[n - 2]);
+
+            if (high < r_hat || (high == r_hat && low <= u[j + n - 2]))
+            {
+                break;
+            }
+
+            --q_hat;
+            r_hat += v[n - 1];
+            r_hat_overflow = r_hat < v[n - 1];
+        }
+
+        // Multiply the divisor by the estimate and subtract it from the remainder.
+        ChunkType borrow = 0;
+        ChunkType carry = 0;
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            auto [low, high] = multiply_chunks(q_hat, v[i]);
+            low += carry;
+            carry = high + static_cast<ChunkType>(low < carry);
+
+            ChunkType const difference = u[i + j] - low;
+            ChunkType const new_borrow = static_cast<ChunkType>(u[i + j] < low);
+            u[i + j] = difference - borrow;
+            borrow = new_borrow | static_cast<ChunkType>(difference < borrow);
+        }
+
+        ChunkType const difference = u[j + n] - carry;
+        bool const negative_result = u[j + n] < carry || difference < borrow;
+        u[j + n] = difference - borrow;
+
+        // The estimate was 1 too large, add the divisor back.
+        if (negative_result)
+        {
+            --q_hat;
+            carry = 0;
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                ChunkType const sum = u[i + j] + v[i] + carry;
+                carry = static_cast<ChunkType>(sum < u[i + j] || (carry != 0 && sum == u[i + j]));
+                u[i + j] = sum;
+            }
+
+            u[j + n] += carry;
+        }
+
+        quotient[j] = q_hat;
+    }
+
+    // Undo the normalization of the remainder.
+    remainder.resize(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        remainder[i] = shift == 0 ? u[i] : (u[i] >> shift) | (u[i + 1] << (chunk_bits - shift));
+    }
+
+    trim(quotient);
+    trim(remainder);
+}
@@ -0,0 +1,110 @@
+#include "bigint/bigint.hpp"
+
+#include <utility>
+
+using namespace BI;
+
+BigIntView::BigIntView(BigInt const &num) noexcept : BigIntView(std::span<ChunkType const>(num.chunks), num.negative)
+{
+}
+
+auto BigIntView::to_string(int base, bool capitalize) const -> std::string
+{
+    return BigInt::format_to_base(*this, BigInt::to_base(base), false, capitalize);
+}
+
+namespace BI
+{
+auto operator+(BigIntView lhs, BigIntView rhs) -> BigInt
+{
+    if (lhs.is_zero())
+    {
+        return BigInt(rhs);
+    }
+
+    if (rhs.is_zero())
+    {
+        return BigInt(lhs);
+    }
+
+    bool const magnitude_greater =
+        BigInt::compare_magnitude(lhs.magnitude, rhs.magnitude) == std::strong_ordering::greater;
+    auto const [larger, smaller] = magnitude_greater ? std::pair{lhs.magnitude, rhs.magnitude}
+                                                     : std::pair{rhs.magnitude, lhs.magnitude};
+
+    BigInt result = lhs.negative == rhs.negative ? BigInt::add_magnitude(larger, smaller)
+                                                 : BigInt::subtract_magnitude(larger, smaller);
+
+    result.negative = (magnitude_greater ? lhs.negative : rhs.negative) && !result.is_zero();
+    return result;
+}
+
+auto operator-(BigIntView lhs, BigIntView rhs) -> BigInt
+{
+    return lhs + -rhs;
+}
+
+auto operator*(BigIntView lhs, BigIntView rhs) -> BigInt
+{
+    return multiply(lhs, rhs, get_default_execution_policy());
+}
+
+auto multiply(BigIntView lhs, BigIntView rhs, ExecutionPolicy const &policy) -> BigInt
+{
+    if (lhs.is_zero() || rhs.is_zero())
+    {
+        return BigInt{};
+    }
+
+    BigInt result{};
+    // log(a * b) = log(a) + log(b).
+    result.chunks.assign(lhs.magnitude.size() + rhs.magnitude.size(), 0);
+
+    BigInt::multiply_magnitude(lhs.magnitude, rhs.magnitude, result.chunks, policy);
+
+    result.remove_leading_zeroes();
+    result.negative = lhs.negative != rhs.negative;
+
+    return result;
+}
+
+auto operator/(BigIntView lhs, BigIntView rhs) -> BigInt
+{
+    return BigInt::div(lhs, rhs).first;
+}
+
+auto operator%(BigIntView lhs, BigIntView rhs) -> BigInt
+{
+    return BigInt::div(lhs, rhs).second;
+}
+
+auto operator<=>(BigIntView lhs, BigIntView rhs) noexcept -> std::strong_ordering
+{
+    if (lhs.negative != rhs.negative)
+    {
+        return lhs.negative ? std::strong_ordering::less : std::strong_ordering::greater;
+    }
+
+    return lhs.negative ? BigInt::compare_magnitude(rhs.magnitude, lhs.magnitude)
+                        : BigInt::compare_magnitude(lhs.magnitude, rhs.magnitude);
+}
+
+auto operator==(BigIntView lhs, BigIntView rhs) noexcept -> bool
+{
+    return lhs.negative == rhs.negative && std::ranges::equal(lhs.magnitude, rhs.magnitude);
+}
+}  // namespace BI
+
+auto std::hash<BI::BigIntView>::operator()(BI::BigIntView num) const noexcept -> size_t
+{
+    // Combine the hashes of the chunks like boost::hash_combine.
+    size_t seed = std::hash<bool>{}(num.is_negative());
+
+    for (auto const chunk : num.chunks())
+    {
+        seed ^= std::hash<BI::BigIntView::ChunkType>{}(chunk) + static_cast<size_t>(0x9E3779B97F4A7C15ULL) + (seed << 6)
+                + (seed >> 2);
+    }
+
+    return seed;
+}
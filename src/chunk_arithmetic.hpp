@@ -0,0 +1,91 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <span>
+
+#include "bigint/bigint.hpp"
+
+namespace BI::detail
+{
+constexpr size_t chunk_bits = sizeof(BigInt::ChunkType) * 8;
+
+/// @brief Get the number of bits of a magnitude without leading zeroes.
+inline auto bit_length(std::span<BigInt::ChunkType const> chunks) noexcept -> size_t
+{
+    return chunks.empty() ? 0 : (chunks.size() * chunk_bits) - static_cast<size_t>(std::countl_zero(chunks.back()));
+}
+
+/// @brief Get the chunk_bits bits of a magnitude starting at the given bit, bits past the end are 0.
+inline auto bits_at(std::span<BigInt::ChunkType const> chunks, size_t position) noexcept -> BigInt::ChunkType
+{
+    size_t const index = position / chunk_bits;
+    size_t const shift = position % chunk_bits;
+
+    if (index >= chunks.size())
+    {
+        return 0;
+    }
+
+    BigInt::ChunkType bits = chunks[index] >> shift;
+
+    if (shift != 0 && index + 1 < chunks.size())
+    {
+        bits |= chunks[index + 1] << (chunk_bits - shift);
+    }
+
+    return bits;
+}
+
+/// @brief Get the number of trailing zero bits of a magnitude, which must not be 0.
+inline auto trailing_zeroes(std::span<BigInt::ChunkType const> chunks) noexcept -> size_t
+{
+    size_t index = 0;
+
+    while (chunks[index] == 0)
+    {
+        ++index;
+    }
+
+    return (index * chunk_bits) + static_cast<size_t>(std::countr_zero(chunks[index]));
+}
+
+/// @brief Get the remainder of a magnitude divided by a number smaller than 2^32.
+///
+/// The magnitude is processed in 16-bit pieces so every intermediate value fits in 64 bits whatever the chunk size.
+inline auto remainder(std::span<BigInt::ChunkType const> chunks, std::uint64_t divisor) noexcept -> std::uint64_t
+{
+    constexpr size_t piece_bits = 16;
+    std::uint64_t result = 0;
+
+    for (auto it = chunks.rbegin(); it != chunks.rend(); ++it)
+    {
+        for (size_t shift = chunk_bits; shift > 0; shift -= piece_bits)
+        {
+            auto const piece = static_cast<std::uint64_t>((*it >> (shift - piece_bits)) & 0xFFFF);
+            result = ((result << piece_bits) | piece) % divisor;
+        }
+    }
+
+    return result;
+}
+
+/// @brief Raise a number to a power modulo a number smaller than 2^32.
+constexpr auto pow_mod(std::uint64_t base, std::uint64_t exponent, std::uint64_t modulus) noexcept -> std::uint64_t
+{
+    std::uint64_t result = 1 % modulus;
+    base %= modulus;
+
+    for (; exponent != 0; exponent >>= 1)
+    {
+        if ((exponent & 1) != 0)
+        {
+            result = (result * base) % modulus;
+        }
+
+        base = (base * base) % modulus;
+    }
+
+    return result;
+}
+}  // namespace BI::detail
@@ -0,0 +1,239 @@
+#include "bigint/bigint.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "combinatorics.hpp"
+
+using namespace BI;
+using namespace BI::detail;
+
+namespace BI::detail
+{
+auto primes_up_to(std::uint64_t limit) -> std::vector<std::uint64_t>
+{
+    std::vector<std::uint64_t> primes;
+
+    if (limit < 2)
+    {
+        return primes;
+    }
+
+    std::vector<bool> composite(limit + 1);
+    primes.push_back(2);
+
+    for (std::uint64_t i = 3; i <= limit; i += 2)
+    {
+        if (composite[i])
+        {
+            continue;
+        }
+
+        primes.push_back(i);
+
+        for (std::uint64_t j = i * i; j <= limit; j += 2 * i)
+        {
+            composite[j] = true;
+        }
+    }
+
+    return primes;
+}
+
+auto product_tree(std::span<std::uint64_t const> factors) -> BigInt
+{
+    std::vector<BigInt> level;
+    std::uint64_t word = 1;
+
+    for (std::uint64_t const factor : factors)
+    {
+        if (word > std::numeric_limits<std::uint64_t>::max() / factor)
+        {
+            level.emplace_back(word);
+            word = 1;
+        }
+
+        word *= factor;
+    }
+
+    level.emplace_back(word);
+
+    // Multiply neighbours until a single number is left.
+    while (level.size() > 1)
+    {
+        std::vector<BigInt> next;
+        next.reserve((level.size() + 1) / 2);
+
+        for (size_t i = 0; i + 1 < level.size(); i += 2)
+        {
+            next.push_back(level[i] * level[i + 1]);
+        }
+        if (level.size() % 2 == 1)
+        {
+            next.push_back(std::move(level.back()));
+        }
+
+        level = std::move(next);
+    }
+
+    return std::move(level.front());
+}
+
+auto swing_factors(std::uint64_t n, std::span<std::uint64_t const> primes) -> std::vector<std::uint64_t>
+{
+    std::vector<std::uint64_t> factors;
+
+    for (std::uint64_t const p : primes)
+    {
+        if (p > n)
+        {
+            break;
+        }
+
+        if (p > n / p)
+        {
+            if (((n / p) & 1) != 0)
+            {
+                factors.push_back(p);
+            }
+
+            continue;
+        }
+
+        for (std::uint64_t q = n / p; q != 0; q /= p)
+        {
+            if ((q & 1) != 0)
+            {
+                factors.push_back(p);
+            }
+        }
+    }
+
+    return factors;
+}
+}  // namespace BI::detail
+
+namespace
+{
+/// @brief Ranges up to this length are multiplied one factor at a time by product().
+constexpr std::uint64_t range_leaf_size = 16;
+
+/// @brief binomial() factorizes C(n, k) only when k > n / factorization_ratio, below that the sieve up to n costs far
+/// more than the k factors.
+constexpr std::uint64_t factorization_ratio = 64;
+
+/// @brief Multiply the integers in [first, last) by binary splitting, so the two halves have about the same size.
+auto range_product(std::uint64_t first, std::uint64_t last) -> BigInt
+{
+    if (last - first <= range_leaf_size)
+    {
+        std::array<std::uint64_t, range_leaf_size> factors{};
+
+        for (std::uint64_t i = first; i < last; ++i)
+        {
+            factors[i - first] = i;
+        }
+
+        return product_tree(std::span(factors).first(last - first));
+    }
+
+    std::uint64_t const middle = first + ((last - first) / 2);
+    return range_product(first, middle) * range_product(middle, last);
+}
+
+/// @brief Get n! as (floor(n / 2)!)^2 times the swinging factorial of n.
+auto swing_factorial(std::uint64_t n, std::span<std::uint64_t const> primes) -> BigInt
+{
+    if (n < small_factorials.size())
+    {
+        return BigInt(small_factorials[n]);
+    }
+
+    BigInt const half = swing_factorial(n / 2, primes);
+    return (half * half) * product_tree(swing_factors(n, primes));
+}
+}  // namespace
+
+namespace BI
+{
+auto product(std::uint64_t first, std::uint64_t last) -> BigInt
+{
+    if (first >= last)
+    {
+        return BigInt(1);
+    }
+    if (first == 0)
+    {
+        return BigInt();
+    }
+
+    return range_product(first, last);
+}
+
+auto factorial(std::uint64_t n) -> BigInt
+{
+    if (n < small_factorials.size())
+    {
+        return BigInt(small_factorials[n]);
+    }
+
+    std::vector<std::uint64_t> const primes = primes_up_to(n);
+    return swing_factorial(n, primes);
+}
+
+auto binomial(std::uint64_t n, std::uint64_t k) -> BigInt
+{
+    if (k > n)
+    {
+        return BigInt();
+    }
+
+    k = std::min(k, n - k);
+
+    // Few factors don't need the factorization, every intermediate result C(n - k + i, i) is an integer.
+    if (k < range_leaf_size)
+    {
+        BigInt result(1);
+
+        for (std::uint64_t i = 1; i <= k; ++i)
+        {
+            result = (result * BigInt(n - k + i)) / BigInt(i);
+        }
+
+        return result;
+    }
+
+    // The division is exact. n + 1 may overflow, so the factor n is multiplied separately.
+    if (k <= n / factorization_ratio)
+    {
+        return (product(n - k + 1, n) * BigInt(n)) / factorial(k);
+    }
+
+    // By Legendre's formula the exponent of p is the sum of floor(n / p^i) - floor(k / p^i) - floor((n - k) / p^i),
+    // which is the number of borrows when subtracting k from n in base p.
+    std::vector<std::uint64_t> factors;
+
+    for (std::uint64_t const p : primes_up_to(n))
+    {
+        for (std::uint64_t a = n / p, b = k / p, c = (n - k) / p; a != 0; a /= p, b /= p, c /= p)
+        {
+            for (std::uint64_t i = 0; i < a - b - c; ++i)
+            {
+                factors.push_back(p);
+            }
+        }
+    }
+
+    return product_tree(factors);
+}
+
+auto primorial(std::uint64_t n) -> BigInt
+{
+    std::vector<std::uint64_t> const primes = primes_up_to(n);
+    return product_tree(primes);
+}
+}  // namespace BI
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "bigint/bigint.hpp"
+
+namespace BI::detail
+{
+/// @brief Factorials that fit in 64 bits.
+inline constexpr auto small_factorials = []
+{
+    std::array<std::uint64_t, 21> result{1};
+
+    for (size_t i = 1; i < result.size(); ++i)
+    {
+        result[i] = result[i - 1] * i;
+    }
+
+    return result;
+}();
+
+/// @brief Get the primes up to a number with a sieve of Eratosthenes.
+[[nodiscard]] auto primes_up_to(std::uint64_t limit) -> std::vector<std::uint64_t>;
+
+/// @brief Multiply small factors into a number.
+///
+/// The factors are first packed into 64-bit words, then the words are multiplied by a balanced product tree so the
+/// operands of every multiplication have about the same size.
+[[nodiscard]] auto product_tree(std::span<std::uint64_t const> factors) -> BigInt;
+
+/// @brief Get the prime factors of the swinging factorial n! / (floor(n / 2)!)^2, with multiplicity.
+///
+/// The exponent of a prime p is the number of odd terms in floor(n / p), floor(n / p^2), ..., so primes above sqrt(n)
+/// appear at most once.
+///
+/// @param n The number.
+/// @param primes The primes up to at least n, in increasing order.
+[[nodiscard]] auto swing_factors(std::uint64_t n, std::span<std::uint64_t const> primes) -> std::vector<std::uint64_t>;
+}  // namespace BI::detail
@@ -0,0 +1,64 @@
+#include "bigint/execution.hpp"
+
+#include <atomic>
+
+namespace
+{
+/// @brief The default policy, guarded by a sequence lock.
+///
+/// The sequence is odd while a writer updates the fields, and readers retry if it was odd or changed while they read
+/// them. Reads never block and never see a policy that was half written.
+struct DefaultPolicy
+{
+    std::atomic<size_t> sequence{0};
+    std::atomic<size_t> threads{BI::ExecutionPolicy::serial().threads};
+    std::atomic<size_t> parallel_threshold{BI::ExecutionPolicy::default_parallel_threshold};
+
+    static auto get() noexcept -> DefaultPolicy &
+    {
+        static DefaultPolicy policy;
+        return policy;
+    }
+};
+}  // namespace
+
+namespace BI
+{
+auto get_default_execution_policy() noexcept -> ExecutionPolicy
+{
+    auto &[sequence, default_threads, default_parallel_threshold] = DefaultPolicy::get();
+
+    while (true)
+    {
+        size_t const before = sequence.load(std::memory_order_acquire);
+        ExecutionPolicy const policy{
+            .threads = default_threads.load(std::memory_order_relaxed),
+            .parallel_threshold = default_parallel_threshold.load(std::memory_order_relaxed)
+        };
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (before % 2 == 0 && sequence.load(std::memory_order_relaxed) == before)
+        {
+            return policy;
+        }
+    }
+}
+
+void set_default_execution_policy(ExecutionPolicy policy) noexcept
+{
+    auto &[sequence, default_threads, default_parallel_threshold] = DefaultPolicy::get();
+
+    // Make the sequence odd, waiting for other writers to finish first.
+    size_t current = sequence.load(std::memory_order_relaxed);
+    while (current % 2 != 0 || !sequence.compare_exchange_weak(current, current + 1, std::memory_order_acquire))
+    {
+        current = sequence.load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+
+    default_threads.store(policy.threads, std::memory_order_relaxed);
+    default_parallel_threshold.store(policy.parallel_threshold, std::memory_order_relaxed);
+
+    sequence.store(current + 2, std::memory_order_release);
+}
+}  // namespace BI
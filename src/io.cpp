@@ -0,0 +1,454 @@
+#include "bigint/bigint.hpp"
+#include "bigint/power_cache.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <cstddef>
+#include <optional>
+#include <istream>
+#include <ostream>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <utility>
+#if defined(__unix__) || defined(__APPLE__)
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+
+#   include <cerrno>
+#else
+#   include <fstream>
+#endif
+
+using namespace BI;
+using namespace BI::detail;
+
+auto BigInt::read(std::istream &is, int base) -> BigInt
+{
+    Base const num_base = to_base(base);
+    auto const base_num = std::to_underlying(num_base);
+
+    std::istream::sentry const sentry(is);
+
+    if (!sentry)
+    {
+        throw std::invalid_argument("Failed to read number from stream");
+    }
+
+    using Traits = std::istream::traits_type;
+    std::streambuf &buffer = *is.rdbuf();
+    BigInt result;
+
+    auto next = buffer.sgetc();
+
+    if (next == '-' || next == '+')
+    {
+        result.negative = next == '-';
+        next = buffer.snextc();
+    }
+
+    // Get the next character in the stream if it's a valid digit, and move past it.
+    auto next_digit = [&]() -> std::optional<char>
+    {
+        if (Traits::eq_int_type(next, Traits::eof()) || !is_valid_digit(num_base, Traits::to_char_type(next)))
+        {
+            return std::nullopt;
+        }
+
+        char const digit = Traits::to_char_type(next);
+        next = buffer.snextc();
+        return digit;
+    };
+
+    size_t digit_count = 0;
+
+    if (std::has_single_bit(static_cast<unsigned>(base_num)))
+    {
+        // The end of the number isn't known in advance, so the bits are packed most significant first and reordered
+        // once all digits have been read.
+        auto const bits_per_digit = static_cast<size_t>(std::countr_zero(base_num));
+        DataType packed;
+        ChunkType current_chunk = 0;
+        size_t current_chunk_bits = 0;
+
+        while (auto const digit_char = next_digit())
+        {
+            ChunkType const digit = char_to_digit(num_base, *digit_char);
+            ++digit_count;
+
+            if (current_chunk_bits + bits_per_digit <= chunk_bits)
+            {
+                current_chunk = (current_chunk << bits_per_digit) | digit;
+                current_chunk_bits += bits_per_digit;
+            }
+            else
+            {
+                // The digit doesn't fit in the current chunk, the least significant bits go to the next chunk.
+                size_t const low_bits = current_chunk_bits + bits_per_digit - chunk_bits;
+                packed.push_back((current_chunk << (bits_per_digit - low_bits)) | (digit >> low_bits));
+                current_chunk = digit & ((static_cast<ChunkType>(1) << low_bits) - 1);
+                current_chunk_bits = low_bits;
+            }
+
+            if (current_chunk_bits == chunk_bits)
+            {
+                packed.push_back(current_chunk);
+                current_chunk = 0;
+                current_chunk_bits = 0;
+            }
+        }
+
+        // The full chunks form the number shifted right by the bits of the last partial chunk.
+        std::ranges::reverse(packed);
+
+        if (current_chunk_bits > 0)
+        {
+            ChunkType carry = current_chunk;
+
+            for (ChunkType &chunk : packed)
+            {
+                ChunkType const new_carry = chunk >> (chunk_bits - current_chunk_bits);
+                chunk = (chunk << current_chunk_bits) | carry;
+                carry = new_carry;
+            }
+
+            packed.push_back(carry);
+        }
+
+        if (!packed.empty())
+        {
+            result.chunks = std::move(packed);
+        }
+    }
+    else
+    {
+        // Digits are converted in blocks that span conversion_threshold chunks. Converted blocks are kept on a stack
+        // and merged in pairs of equal size, which builds the same balanced tree as the divide-and-conquer conversion
+        // of a string without ever holding all of the digits.
+        size_t const block_size = conversion_threshold * digits_per_chunk(num_base);
+        static_assert(std::has_single_bit(conversion_threshold), "conversion_threshold must be a power of two");
+
+        // powers[i] is the power of the base that spans a block merged i times.
+        std::vector<SharedBigInt> powers;
+        std::vector<std::pair<BigInt, size_t>> stack;
+        std::string block;
+        block.reserve(block_size);
+
+        auto power = [&](size_t level) -> BigInt const &
+        {
+            while (powers.size() <= level)
+            {
+                powers.push_back(cached_power(base_num, block_size << powers.size()));
+            }
+
+            return powers[level].get();
+        };
+
+        auto convert_block = [num_base, &block]() -> BigInt
+        {
+            BigInt value;
+            value.big_base_to_binary(block, num_base);
+            return value;
+        };
+
+        while (auto const digit = next_digit())
+        {
+            ++digit_count;
+            block += *digit;
+
+            if (block.size() < block_size)
+            {
+                continue;
+            }
+
+            BigInt value = convert_block();
+            block.clear();
+            size_t level = 0;
+
+            while (!stack.empty() && stack.back().second == level)
+            {
+                value = (stack.back().first * power(level)) + value;
+                stack.pop_back();
+                ++level;
+            }
+
+            stack.emplace_back(std::move(value), level);
+        }
+
+        // Merge the partial last block and the remaining blocks, from the least significant to the most significant.
+        BigInt value = block.empty() ? BigInt{} : convert_block();
+        BigInt scale(cached_power(base_num, block.size()));
+
+        for (size_t i = stack.size(); i-- > 0;)
+        {
+            value = (stack[i].first * scale) + value;
+
+            if (i > 0)
+            {
+                scale *= power(stack[i].second);
+            }
+        }
+
+        result.chunks = std::move(value.chunks);
+    }
+
+    if (Traits::eq_int_type(next, Traits::eof()))
+    {
+        is.setstate(std::ios::eofbit);
+    }
+
+    if (digit_count == 0)
+    {
+        is.setstate(std::ios::failbit);
+        throw std::invalid_argument("Failed to read number from stream");
+    }
+
+    result.remove_leading_zeroes();
+    return result;
+}
+
+auto BigInt::from_file(std::filesystem::path const &path, int base) -> BigInt
+{
+#if defined(__unix__) || defined(__APPLE__)
+    auto throw_system_error = [&path](std::string_view action)
+    {
+        throw std::system_error(
+            errno, std::generic_category(), std::format("Failed to {} \"{}\"", action, path.string())
+        );
+    };
+
+    int const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0)
+    {
+        throw_system_error("open");
+    }
+
+    struct stat info{};
+
+    if (::fstat(fd, &info) != 0)
+    {
+        ::close(fd);
+        throw_system_error("read");
+    }
+
+    auto const size = static_cast<size_t>(info.st_size);
+
+    if (size == 0)
+    {
+        ::close(fd);
+        throw std::invalid_argument(std::format("File \"{}\" is empty", path.string()));
+    }
+
+    void *const data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid after the file is closed.
+    ::close(fd);
+
+    if (data == MAP_FAILED)
+    {
+        throw_system_error("map");
+    }
+
+    // Unmap the file when leaving the scope, even if parsing throws.
+    auto unmap = [size](void *ptr) { ::munmap(ptr, size); };
+    std::unique_ptr<void, decltype(unmap)> const mapping(data, unmap);
+
+    ::madvise(data, size, MADV_SEQUENTIAL);
+
+    std::string_view text(static_cast<char const *>(mapping.get()), size);
+    auto const is_space = [](char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; };
+
+    while (!text.empty() && is_space(text.front()))
+    {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && is_space(text.back()))
+    {
+        text.remove_suffix(1);
+    }
+
+    return BigInt(text, base);
+#else
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file)
+    {
+        throw std::system_error(
+            std::make_error_code(std::errc::no_such_file_or_directory),
+            std::format("Failed to open \"{}\"", path.string())
+        );
+    }
+
+    BigInt result = read(file, base);
+
+    // Only trailing whitespace may follow the number.
+    if (!(file >> std::ws).eof())
+    {
+        throw std::invalid_argument(std::format("File \"{}\" doesn't contain a valid number", path.string()));
+    }
+
+    return result;
+#endif
+}
+
+void BigInt::write(std::ostream &os, int base, bool capitalize) const
+{
+    Base const num_base = to_base(base);
+    std::ostream::sentry const sentry(os);
+
+    if (!sentry)
+    {
+        return;
+    }
+
+    auto const flags = os.flags();
+    std::string_view const sign = (negative && !is_zero())           ? "-"
+                                  : (flags & std::ios::showpos) != 0 ? "+"
+                                                                     : "";
+    std::string_view const prefix = (flags & std::ios::showbase) != 0 ? base_prefix(*this, num_base, capitalize) : "";
+
+    // The width only applies to the next output, reset it like the standard integer output does.
+    auto const width = static_cast<size_t>(std::max<std::streamsize>(os.width(0), 0));
+    size_t const length = width > 0 ? sign.size() + prefix.size() + digit_count(*this, num_base) : 0;
+    size_t const padding = width > length ? width - length : 0;
+    auto const adjust = flags & std::ios::adjustfield;
+
+    auto put = [&os](std::string_view str) { os.write(str.data(), static_cast<std::streamsize>(str.size())); };
+    auto put_fill = [&os](size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            os.put(os.fill());
+        }
+    };
+
+    if (adjust != std::ios::left && adjust != std::ios::internal)
+    {
+        put_fill(padding);
+    }
+
+    put(sign);
+    put(prefix);
+
+    if (adjust == std::ios::internal)
+    {
+        put_fill(padding);
+    }
+
+    write_digits(*this, num_base, capitalize, put);
+
+    if (adjust == std::ios::left)
+    {
+        put_fill(padding);
+    }
+}
+
+void BigInt::to_file(std::filesystem::path const &path, int base, bool capitalize) const
+{
+    Base const num_base = to_base(base);
+    std::string_view const sign = (negative && !is_zero()) ? "-" : "";
+
+#if defined(__unix__) || defined(__APPLE__)
+    auto throw_system_error = [&path](std::string_view action)
+    {
+        throw std::system_error(
+            errno, std::generic_category(), std::format("Failed to {} \"{}\"", action, path.string())
+        );
+    };
+
+    int const fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+    if (fd < 0)
+    {
+        throw_system_error("open");
+    }
+
+    // Close the file when leaving the scope, even if writing throws.
+    auto close_file = [](int const *file) { ::close(*file); };
+    std::unique_ptr<int const, decltype(close_file)> const file(&fd, close_file);
+
+    auto put = [&fd, &throw_system_error](std::string_view block)
+    {
+        while (!block.empty())
+        {
+            ssize_t const written = ::write(fd, block.data(), block.size());
+
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                throw_system_error("write");
+            }
+
+            block.remove_prefix(static_cast<size_t>(written));
+        }
+    };
+
+    put(sign);
+    write_digits(*this, num_base, capitalize, put);
+#else
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+    if (!file)
+    {
+        throw std::system_error(
+            std::make_error_code(std::errc::io_error), std::format("Failed to open \"{}\"", path.string())
+        );
+    }
+
+    file << sign;
+    write_digits(
+        *this,
+        num_base,
+        capitalize,
+        [&file](std::string_view block) { file.write(block.data(), static_cast<std::streamsize>(block.size())); }
+    );
+
+    if (!file.flush())
+    {
+        throw std::system_error(
+            std::make_error_code(std::errc::io_error), std::format("Failed to write \"{}\"", path.string())
+        );
+    }
+#endif
+}
+
+auto operator<<(std::ostream &os, BigInt const &num) -> std::ostream &
+{
+    auto const basefield = os.flags() & std::ios::basefield;
+    int const base = basefield == std::ios::hex ? 16 : basefield == std::ios::oct ? 8 : 10;
+
+    num.write(os, base, (os.flags() & std::ios::uppercase) != 0);
+    return os;
+}
+
+auto operator>>(std::istream &is, BigInt &num) -> std::istream &
+{
+    int base = 10;
+
+    if ((is.flags() & std::ios::basefield) == std::ios::hex)
+    {
+        base = 16;
+    }
+    else if ((is.flags() & std::ios::basefield) == std::ios::oct)
+    {
+        base = 8;
+    }
+
+    try
+    {
+        num = BigInt::read(is, base);
+    }
+    catch (std::invalid_argument const &)
+    {
+        // The stream state already reflects the failure.
+    }
+
+    return is;
+}
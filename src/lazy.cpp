@@ -0,0 +1,348 @@
+#include "bigint/lazy.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
+
+using namespace BI;
+using namespace BI::detail;
+
+namespace
+{
+using ChunkType = BigInt::ChunkType;
+
+constexpr size_t chunk_bits = sizeof(ChunkType) * 8;
+
+auto is_zero(LazyTerm const &term) noexcept -> bool
+{
+    return term.value.is_zero() || (term.product && term.factor.is_zero());
+}
+
+auto is_negative(LazyTerm const &term) noexcept -> bool
+{
+    return term.value.is_negative() != (term.product && term.factor.is_negative());
+}
+
+/// @brief Check if a term is a product of two numbers of several chunks, which needs a full multiplication.
+auto is_full_product(LazyTerm const &term) noexcept -> bool
+{
+    return term.product && term.value.chunks().size() > 1 && term.factor.chunks().size() > 1;
+}
+
+/// @brief Get the number of chunks written for a term, 0 if it's 0.
+auto term_size(LazyTerm const &term) noexcept -> size_t
+{
+    if (is_zero(term))
+    {
+        return 0;
+    }
+
+    size_t const size = term.value.chunks().size();
+
+    if (term.product)
+    {
+        return size + term.factor.chunks().size();
+    }
+
+    return term.shift == 0 ? size : size + (term.shift / chunk_bits) + 1;
+}
+
+/// @brief Split a product by a single chunk in the chunks of the other factor and the single chunk.
+auto small_factors(LazyTerm const &term) noexcept -> std::pair<std::span<ChunkType const>, ChunkType>
+{
+    if (term.factor.chunks().size() == 1)
+    {
+        return {term.value.chunks(), term.factor.chunks().front()};
+    }
+
+    return {term.factor.chunks(), term.value.chunks().front()};
+}
+
+/// @brief Get chunk i of a magnitude shifted left by less than a chunk, i goes up to chunks.size().
+auto shifted_chunk(std::span<ChunkType const> chunks, size_t bits, size_t i) noexcept -> ChunkType
+{
+    ChunkType const low = i < chunks.size() ? chunks[i] << bits : 0;
+    ChunkType const high = bits != 0 && i > 0 ? chunks[i - 1] >> (chunk_bits - bits) : 0;
+    return low | high;
+}
+
+/// @brief Check if a view points into a buffer.
+auto views(BigIntView num, std::span<ChunkType const> buffer) noexcept -> bool
+{
+    ChunkType const *const data = num.chunks().data();
+    return !num.is_zero() && std::greater_equal<>()(data, buffer.data())
+           && std::less<>()(data, std::to_address(buffer.end()));
+}
+
+/// @brief Add or subtract count chunks to a buffer and propagate the carry to its end.
+///
+/// @param chunk Called with 0, 1, ... count - 1 in this order, returns the chunks to add.
+template<bool Subtract, typename Chunk>
+void combine(std::span<ChunkType> buffer, size_t count, Chunk const &chunk)
+{
+    ChunkType carry = 0;
+    size_t i = 0;
+
+    for (; i < count; ++i)
+    {
+        ChunkType const operand = chunk(i);
+
+        if constexpr (Subtract)
+        {
+            ChunkType const difference = buffer[i] - operand;
+            ChunkType const result = difference - carry;
+            carry = static_cast<ChunkType>(buffer[i] < operand) | static_cast<ChunkType>(difference < carry);
+            buffer[i] = result;
+        }
+        else
+        {
+            ChunkType const sum = buffer[i] + operand;
+            ChunkType const result = sum + carry;
+            carry = static_cast<ChunkType>(sum < operand) | static_cast<ChunkType>(result < sum);
+            buffer[i] = result;
+        }
+    }
+
+    for (; carry != 0 && i < buffer.size(); ++i)
+    {
+        if constexpr (Subtract)
+        {
+            carry = static_cast<ChunkType>(buffer[i] == 0);
+            --buffer[i];
+        }
+        else
+        {
+            ++buffer[i];
+            carry = static_cast<ChunkType>(buffer[i] == 0);
+        }
+    }
+}
+
+template<typename Chunk>
+void combine(std::span<ChunkType> buffer, size_t count, bool subtract, Chunk const &chunk)
+{
+    if (subtract)
+    {
+        combine<true>(buffer, count, chunk);
+    }
+    else
+    {
+        combine<false>(buffer, count, chunk);
+    }
+}
+
+/// @brief Negate a number stored in two's complement.
+void negate(std::span<ChunkType> buffer) noexcept
+{
+    ChunkType carry = 1;
+
+    for (ChunkType &chunk : buffer)
+    {
+        chunk = ~chunk + carry;
+        carry &= static_cast<ChunkType>(chunk == 0);
+    }
+}
+}  // namespace
+
+void LazyEvaluator::sum(std::span<LazyTerm const> terms, BigInt &result)
+{
+    size_t size = 0;
+
+    for (LazyTerm const &term : terms)
+    {
+        size = std::max(size, term_size(term));
+    }
+
+    if (size == 0)
+    {
+        result.chunks.assign(1, 0);
+        result.negative = false;
+        return;
+    }
+
+    // The sum of fewer than 2^(chunk_bits - 1) terms and its sign fit in one more chunk.
+    ++size;
+
+    std::span<ChunkType const> const storage(result.chunks.data(), result.chunks.capacity());
+    auto const views_result = [storage](LazyTerm const &term)
+    { return views(term.value, storage) || (term.product && views(term.factor, storage)); };
+
+    auto first = std::ranges::find_if(terms, views_result);
+
+    if (first == terms.end())
+    {
+        // A full product is written directly, the others go through the scratch buffer.
+        first = std::ranges::find_if(terms, is_full_product);
+        first = first == terms.end() ? terms.begin() : first;
+
+        if (result.chunks.capacity() < size)
+        {
+            // Nothing needs to be copied to the new buffer.
+            result.chunks.clear();
+        }
+    }
+    else
+    {
+        // A term viewing the result can only be written in place, from where the result starts and without moving it.
+        std::span<ChunkType const> const source = first->product ? small_factors(*first).first : first->value.chunks();
+
+        if (std::ranges::count_if(terms, views_result) > 1 || is_full_product(*first) ||
+            source.data() != storage.data() || result.chunks.capacity() < size)
+        {
+            BigInt temporary;
+            sum(terms, temporary);
+            result = std::move(temporary);
+            return;
+        }
+    }
+
+    result.chunks.resize(size);
+    std::span<ChunkType> const buffer(result.chunks);
+
+    std::fill(buffer.begin() + static_cast<std::ptrdiff_t>(write(*first, buffer)), buffer.end(), 0);
+
+    if (is_negative(*first))
+    {
+        negate(buffer);
+    }
+
+    std::vector<ChunkType> scratch;
+
+    for (auto it = terms.begin(); it != terms.end(); ++it)
+    {
+        if (it != first)
+        {
+            accumulate(*it, buffer, scratch);
+        }
+    }
+
+    bool const negative = (buffer.back() >> (chunk_bits - 1)) != 0;
+
+    if (negative)
+    {
+        negate(buffer);
+    }
+
+    result.remove_leading_zeroes();
+    result.negative = negative && !result.is_zero();
+}
+
+auto LazyEvaluator::write(LazyTerm const &term, std::span<ChunkType> buffer) -> size_t
+{
+    if (is_zero(term))
+    {
+        return 0;
+    }
+
+    if (is_full_product(term))
+    {
+        std::span<ChunkType> const product = buffer.first(term_size(term));
+        std::ranges::fill(product, 0);
+        BigInt::multiply_magnitude(term.value.chunks(), term.factor.chunks(), product, get_default_execution_policy());
+        return product.size();
+    }
+
+    if (term.product)
+    {
+        // The multiplier is read before anything is written, from the least significant chunk.
+        auto const [chunks, multiplier] = small_factors(term);
+        ChunkType carry = 0;
+
+        for (size_t i = 0; i < chunks.size(); ++i)
+        {
+            auto [low, high] = BigInt::multiply_chunks(chunks[i], multiplier);
+            low += carry;
+            carry = high + static_cast<ChunkType>(low < carry);
+            buffer[i] = low;
+        }
+
+        buffer[chunks.size()] = carry;
+        return chunks.size() + 1;
+    }
+
+    std::span<ChunkType const> const chunks = term.value.chunks();
+
+    if (term.shift == 0)
+    {
+        if (chunks.data() != buffer.data())
+        {
+            std::ranges::copy(chunks, buffer.begin());
+        }
+
+        return chunks.size();
+    }
+
+    size_t const offset = term.shift / chunk_bits;
+    size_t const bits = term.shift % chunk_bits;
+
+    // From the most significant chunk, every chunk is read before it's overwritten.
+    for (size_t i = chunks.size() + 1; i-- > 0;)
+    {
+        buffer[offset + i] = shifted_chunk(chunks, bits, i);
+    }
+
+    std::fill_n(buffer.begin(), offset, 0);
+    return chunks.size() + offset + 1;
+}
+
+void LazyEvaluator::accumulate(LazyTerm const &term, std::span<ChunkType> buffer, std::vector<ChunkType> &scratch)
+{
+    if (is_zero(term))
+    {
+        return;
+    }
+
+    bool const subtract = is_negative(term);
+
+    if (is_full_product(term))
+    {
+        scratch.assign(term_size(term), 0);
+        BigInt::multiply_magnitude(term.value.chunks(), term.factor.chunks(), scratch, get_default_execution_policy());
+        combine(buffer, scratch.size(), subtract, [&scratch](size_t i) { return scratch[i]; });
+    }
+    else if (term.product)
+    {
+        // The chunks of the product are computed while they are added.
+        auto const [chunks, multiplier] = small_factors(term);
+        ChunkType carry = 0;
+
+        combine(
+            buffer,
+            chunks.size() + 1,
+            subtract,
+            [&](size_t i)
+            {
+                if (i == chunks.size())
+                {
+                    return carry;
+                }
+
+                auto [low, high] = BigInt::multiply_chunks(chunks[i], multiplier);
+                low += carry;
+                carry = high + static_cast<ChunkType>(low < carry);
+                return low;
+            }
+        );
+    }
+    else
+    {
+        std::span<ChunkType const> const chunks = term.value.chunks();
+        size_t const bits = term.shift % chunk_bits;
+        std::span<ChunkType> const target = buffer.subspan(term.shift / chunk_bits);
+
+        if (bits == 0)
+        {
+            combine(target, chunks.size(), subtract, [chunks](size_t i) { return chunks[i]; });
+        }
+        else
+        {
+            combine(
+                target,
+                chunks.size() + 1,
+                subtract,
+                [chunks, bits](size_t i) { return shifted_chunk(chunks, bits, i); }
+            );
+        }
+    }
+}
@@ -0,0 +1,207 @@
+#include "bigint/montgomery.hpp"
+#include "bigint/power_cache.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace BI;
+using namespace BI::detail;
+
+namespace
+{
+using ChunkType = BigInt::ChunkType;
+
+constexpr size_t chunk_bits = sizeof(ChunkType) * 8;
+
+/// @brief Select between two chunks without branching.
+///
+/// @param mask All ones to select a, all zeroes to select b.
+constexpr auto select(ChunkType mask, ChunkType a, ChunkType b) noexcept -> ChunkType
+{
+    return (a & mask) | (b & ~mask);
+}
+
+/// @brief Copy the chunks of a non-negative number smaller than the modulus, padded with zeroes to size chunks.
+auto padded_chunks(BigIntView num, size_t size) -> std::vector<ChunkType>
+{
+    std::vector<ChunkType> result(num.chunks().begin(), num.chunks().end());
+    result.resize(size, 0);
+    return result;
+}
+}  // namespace
+
+Montgomery::Montgomery(BigIntView num) : modulus(num.chunks().begin(), num.chunks().end())
+{
+    if (modulus.empty() || (modulus[0] & 1) == 0 || (modulus.size() == 1 && modulus[0] == 1))
+    {
+        throw std::domain_error("Montgomery modulus must be odd and greater than 1");
+    }
+
+    // Newton's iteration for m^-1 mod 2^chunk_bits. Every odd number is its own inverse modulo 8, and every iteration
+    // doubles the number of correct bits.
+    ChunkType m_inverse = modulus[0];
+
+    for (size_t bits = 3; bits < chunk_bits; bits *= 2)
+    {
+        m_inverse *= 2 - (modulus[0] * m_inverse);
+    }
+
+    inverse = 0 - m_inverse;
+
+    BigInt const m(num.abs());
+    BigInt const r = BigIntView(cached_power(2, size() * chunk_bits)) % m;
+
+    r_mod = padded_chunks(r, size());
+    r_squared = padded_chunks((r * r) % m, size());
+}
+
+void Montgomery::multiply(
+    std::span<ChunkType const> lhs,
+    std::span<ChunkType const> rhs,
+    std::span<ChunkType> result,
+    std::span<ChunkType> scratch
+) const noexcept
+{
+    size_t const n = size();
+    assert(lhs.size() == n && rhs.size() == n && result.size() == n && scratch.size() >= scratch_size());
+
+    // Multiply and reduce one chunk of rhs at a time, so the intermediate result never exceeds n + 2 chunks.
+    std::span<ChunkType> const t = scratch.first(n + 2);
+    std::ranges::fill(t, 0);
+
+    // a * b + c + d, which always fits in two chunks.
+    auto multiply_add = [](ChunkType a, ChunkType b, ChunkType c, ChunkType d) -> std::pair<ChunkType, ChunkType>
+    {
+        auto [low, high] = BigInt::multiply_chunks(a, b);
+        low += c;
+        high += static_cast<ChunkType>(low < c);
+        low += d;
+        high += static_cast<ChunkType>(low < d);
+        return {low, high};
+    };
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        // t += lhs * rhs[i]
+        ChunkType carry = 0;
+
+        for (size_t j = 0; j < n; ++j)
+        {
+            std::tie(t[j], carry) = multiply_add(lhs[j], rhs[i], t[j], carry);
+        }
+
+        t[n] += carry;
+        t[n + 1] = static_cast<ChunkType>(t[n] < carry);
+
+        // t = (t + q * m) / 2^chunk_bits, where q makes the lowest chunk 0.
+        ChunkType const q = t[0] * inverse;
+        carry = multiply_add(q, modulus[0], t[0], 0).second;
+
+        for (size_t j = 1; j < n; ++j)
+        {
+            std::tie(t[j - 1], carry) = multiply_add(q, modulus[j], t[j], carry);
+        }
+
+        t[n - 1] = t[n] + carry;
+        t[n] = t[n + 1] + static_cast<ChunkType>(t[n - 1] < carry);
+    }
+
+    // t < 2m, a single conditional subtraction fully reduces it.
+    reduce_once(t.first(n), t[n], result);
+}
+
+void Montgomery::add(std::span<ChunkType const> lhs, std::span<ChunkType const> rhs, std::span<ChunkType> result)
+    const noexcept
+{
+    ChunkType carry = 0;
+
+    for (size_t i = 0; i < size(); ++i)
+    {
+        ChunkType const sum = lhs[i] + rhs[i];
+        ChunkType const overflow = static_cast<ChunkType>(sum < rhs[i]);
+        result[i] = sum + carry;
+        carry = overflow | static_cast<ChunkType>(result[i] < carry);
+    }
+
+    reduce_once(result, carry, result);
+}
+
+void Montgomery::subtract(std::span<ChunkType const> lhs, std::span<ChunkType const> rhs, std::span<ChunkType> result)
+    const noexcept
+{
+    ChunkType borrow = 0;
+
+    for (size_t i = 0; i < size(); ++i)
+    {
+        ChunkType const difference = lhs[i] - rhs[i];
+        ChunkType const underflow = static_cast<ChunkType>(lhs[i] < rhs[i]);
+        result[i] = difference - borrow;
+        borrow = underflow | static_cast<ChunkType>(difference < borrow);
+    }
+
+    // Add the modulus back if the subtraction underflowed.
+    ChunkType const mask = 0 - borrow;
+    ChunkType carry = 0;
+
+    for (size_t i = 0; i < size(); ++i)
+    {
+        ChunkType const addend = modulus[i] & mask;
+        ChunkType const sum = result[i] + addend;
+        ChunkType const overflow = static_cast<ChunkType>(sum < addend);
+        result[i] = sum + carry;
+        carry = overflow | static_cast<ChunkType>(result[i] < carry);
+    }
+}
+
+void Montgomery::to_montgomery(BigIntView value, std::span<ChunkType> result) const
+{
+    BigInt reduced = BigInt(value) % BigInt(BigIntView(modulus));
+
+    if (reduced < BigInt())
+    {
+        reduced += BigInt(BigIntView(modulus));
+    }
+
+    std::vector<ChunkType> const chunks = padded_chunks(reduced, size());
+    std::vector<ChunkType> scratch(scratch_size());
+    multiply(chunks, r_squared, result, scratch);
+}
+
+auto Montgomery::from_montgomery(std::span<ChunkType const> residue) const -> BigInt
+{
+    // Multiplying by 1 divides by R.
+    std::vector<ChunkType> one_chunks(size(), 0);
+    one_chunks[0] = 1;
+
+    std::vector<ChunkType> result(size());
+    std::vector<ChunkType> scratch(scratch_size());
+    multiply(residue, one_chunks, result, scratch);
+
+    return BigInt(BigIntView(result));
+}
+
+void Montgomery::reduce_once(std::span<ChunkType const> low, ChunkType high, std::span<ChunkType> result)
+    const noexcept
+{
+    // Find out if the value is smaller than the modulus without storing the difference, so result may alias low.
+    ChunkType borrow = 0;
+
+    for (size_t i = 0; i < size(); ++i)
+    {
+        ChunkType const difference = low[i] - modulus[i];
+        borrow = static_cast<ChunkType>(low[i] < modulus[i]) | static_cast<ChunkType>(difference < borrow);
+    }
+
+    // All ones if the modulus must be subtracted.
+    ChunkType const mask = 0 - static_cast<ChunkType>(high >= borrow);
+    borrow = 0;
+
+    for (size_t i = 0; i < size(); ++i)
+    {
+        ChunkType const difference = low[i] - modulus[i];
+        ChunkType const underflow = static_cast<ChunkType>(low[i] < modulus[i]);
+        ChunkType const reduced = difference - borrow;
+        borrow = underflow | static_cast<ChunkType>(difference < borrow);
+        result[i] = select(mask, reduced, low[i]);
+    }
+}
@@ -0,0 +1,636 @@
+#include "bigint/bigint.hpp"
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "bigint/montgomery.hpp"
+#include "chunk_arithmetic.hpp"
+
+using namespace BI;
+using namespace BI::detail;
+
+namespace
+{
+using ChunkType = BigInt::ChunkType;
+using SignedChunk = std::make_signed_t<ChunkType>;
+
+/// @brief Number of leading bits used by Lehmer's algorithm. The cofactors are bounded by 2^lehmer_bits and the
+/// intermediate sums by twice that, which must fit in a SignedChunk.
+constexpr size_t lehmer_bits = chunk_bits - 4;
+constexpr ChunkType lehmer_mask = (static_cast<ChunkType>(1) << lehmer_bits) - 1;
+
+/// @brief Matrix of a sequence of Euclid steps, (u, v) becomes (a * u + b * v, c * u + d * v).
+struct EuclidMatrix
+{
+    SignedChunk a{1};
+    SignedChunk b{0};
+    SignedChunk c{0};
+    SignedChunk d{1};
+};
+
+/// @brief Find the Euclid steps that are determined by the leading bits of two numbers (Knuth's Algorithm L).
+///
+/// @param x Leading bits of the larger number.
+/// @param y Bits of the smaller number at the same position.
+/// @return The matrix of the steps, the identity matrix if no step is determined.
+auto lehmer_matrix(SignedChunk x, SignedChunk y) noexcept -> EuclidMatrix
+{
+    EuclidMatrix m;
+
+    // The quotients of (x + a) / (y + c) and (x + b) / (y + d) bound the quotient of the full numbers, stop as soon as
+    // they differ.
+    while (y + m.c != 0 && y + m.d != 0)
+    {
+        SignedChunk const q = (x + m.a) / (y + m.c);
+
+        if (q != (x + m.b) / (y + m.d))
+        {
+            break;
+        }
+
+        m = {m.c, m.d, m.a - (q * m.c), m.b - (q * m.d)};
+        x = std::exchange(y, x - (q * y));
+    }
+
+    return m;
+}
+
+/// @brief Get the window size of the sliding window exponentiation for an exponent of the given number of bits.
+///
+/// Larger windows need fewer multiplications but more precomputed powers, the thresholds minimize their sum.
+constexpr auto window_bits(size_t exponent_bits) noexcept -> size_t
+{
+    constexpr std::array thresholds{7, 25, 81, 241, 673};
+    size_t bits = 1;
+
+    for (auto const threshold : thresholds)
+    {
+        if (exponent_bits <= static_cast<size_t>(threshold))
+        {
+            break;
+        }
+
+        ++bits;
+    }
+
+    return bits;
+}
+
+/// @brief Raise a value to a power with a left-to-right sliding window.
+///
+/// @param base The value to raise.
+/// @param one The identity of the multiplication.
+/// @param exponent Chunks of the power in little endian, without leading zeroes.
+/// @param multiply Callback that multiplies its first argument by the second one in place.
+/// @return base^exponent.
+template<typename Value, typename Multiply>
+auto sliding_window_pow(Value const &base, Value const &one, std::span<ChunkType const> exponent, Multiply multiply)
+    -> Value
+{
+    size_t const bits = bit_length(exponent);
+    size_t const window = window_bits(bits);
+    auto bit_at = [&exponent](size_t position)
+    { return ((exponent[position / chunk_bits] >> (position % chunk_bits)) & 1) != 0; };
+
+    // Odd powers base^1, base^3, ..., base^(2^window - 1).
+    size_t const power_count = static_cast<size_t>(1) << (window - 1);
+    std::vector<Value> powers{base};
+    powers.reserve(power_count);
+
+    if (window > 1)
+    {
+        Value square = base;
+        multiply(square, base);
+
+        while (powers.size() < power_count)
+        {
+            powers.push_back(powers.back());
+            multiply(powers.back(), square);
+        }
+    }
+
+    Value result = one;
+    bool is_one = true;
+
+    for (size_t position = bits; position > 0;)
+    {
+        if (!bit_at(position - 1))
+        {
+            multiply(result, result);
+            --position;
+            continue;
+        }
+
+        // The window spans from the current bit down to the lowest set bit within the window size.
+        size_t low = position > window ? position - window : 0;
+
+        while (!bit_at(low))
+        {
+            ++low;
+        }
+
+        ChunkType const window_mask = (static_cast<ChunkType>(1) << (position - low)) - 1;
+        auto const value = static_cast<size_t>(bits_at(exponent, low) & window_mask);
+
+        if (is_one)
+        {
+            result = powers[value >> 1];
+            is_one = false;
+        }
+        else
+        {
+            for (size_t i = low; i < position; ++i)
+            {
+                multiply(result, result);
+            }
+
+            multiply(result, powers[value >> 1]);
+        }
+
+        position = low;
+    }
+
+    return result;
+}
+
+/// @brief Invert values in place with Montgomery's trick, which needs a single inversion and 3(n - 1) multiplications.
+///
+/// @param values The values to invert, only overwritten once all of them are known to be invertible.
+/// @param modulus The modulus, at least 1.
+/// @param convert Callback that converts a number to a Value.
+/// @param multiply Callback that multiplies its first argument by the second one in place, modulo the modulus.
+/// @param restore Callback that converts a Value back to a number in [0, modulus).
+///
+/// @throws std::domain_error if a value is not coprime with the modulus.
+template<typename Convert, typename Multiply, typename Restore>
+void montgomery_trick(
+    std::span<BigInt> values, BigIntView modulus, Convert convert, Multiply multiply, Restore restore
+)
+{
+    using Value = std::invoke_result_t<Convert, BigIntView>;
+
+    std::vector<Value> converted;
+    std::vector<Value> prefixes;
+    converted.reserve(values.size());
+    prefixes.reserve(values.size());
+
+    // prefixes[i] holds the product of the first i + 1 values.
+    for (BigInt const &value : values)
+    {
+        converted.push_back(convert(value));
+        prefixes.push_back(converted.back());
+
+        if (prefixes.size() > 1)
+        {
+            multiply(prefixes.back(), prefixes[prefixes.size() - 2]);
+        }
+    }
+
+    // The product is invertible if and only if all the values are.
+    Value inverse = convert(invert(restore(prefixes.back()), modulus));
+
+    // inverse holds the inverse of the product of the first i + 1 values, so multiplying it by the product of the
+    // first i values gives the inverse of the value i.
+    for (size_t i = values.size() - 1; i > 0; --i)
+    {
+        Value value_inverse = inverse;
+        multiply(value_inverse, prefixes[i - 1]);
+        multiply(inverse, converted[i]);
+        values[i] = restore(value_inverse);
+    }
+
+    values[0] = restore(inverse);
+}
+
+/// @brief Check the arguments of a modular exponentiation.
+///
+/// @throws std::domain_error if the modulus is 0 or the exponent is negative.
+void check_powm_arguments(BigIntView exponent, BigIntView modulus)
+{
+    if (modulus.is_zero())
+    {
+        throw std::domain_error("Modulus must not be 0");
+    }
+    if (exponent.is_negative())
+    {
+        throw std::domain_error("Exponent must not be negative");
+    }
+}
+}  // namespace
+
+auto BigInt::binary_gcd(ChunkType a, ChunkType b) noexcept -> ChunkType
+{
+    if (a == 0 || b == 0)
+    {
+        return a | b;
+    }
+
+    // Common factors of two are removed first and restored at the end, the rest of the factors of two don't matter.
+    auto const shift = std::countr_zero(a | b);
+    a >>= std::countr_zero(a);
+
+    do
+    {
+        b >>= std::countr_zero(b);
+
+        if (a > b)
+        {
+            std::swap(a, b);
+        }
+
+        b -= a;
+    } while (b != 0);
+
+    return a << shift;
+}
+
+void BigInt::lehmer_reduce(BigInt &u, BigInt &v, std::pair<BigInt, BigInt> *cofactors)
+{
+    assert(u.compare_magnitude(v) != std::strong_ordering::less);
+
+    // One row of the matrix, cu * u + cv * v, computed chunk by chunk. The coefficients have opposite signs (or one of
+    // them is 0) and the result isn't negative, so it's the product by the non-negative coefficient minus the other
+    // one.
+    struct Row
+    {
+        Row(SignedChunk cu, SignedChunk cv) noexcept
+            : u_positive{cu > 0 || cv <= 0},
+              positive{static_cast<ChunkType>(u_positive ? cu : cv)},
+              negative{static_cast<ChunkType>(-(u_positive ? cv : cu))}
+        {
+        }
+
+        /// @brief Get the next chunk of the result from the next chunks of u and v.
+        auto next(ChunkType u_chunk, ChunkType v_chunk) noexcept -> ChunkType
+        {
+            auto [positive_low, positive_high] = multiply_chunks(positive, u_positive ? u_chunk : v_chunk);
+            positive_low += positive_carry;
+            positive_carry = positive_high + static_cast<ChunkType>(positive_low < positive_carry);
+
+            auto [negative_low, negative_high] = multiply_chunks(negative, u_positive ? v_chunk : u_chunk);
+            negative_low += negative_carry;
+            negative_carry = negative_high + static_cast<ChunkType>(negative_low < negative_carry);
+
+            ChunkType const difference = positive_low - negative_low;
+            ChunkType const result = difference - borrow;
+            borrow = static_cast<ChunkType>(positive_low < negative_low) | static_cast<ChunkType>(difference < borrow);
+            return result;
+        }
+
+        /// @brief Get the chunk above the last chunk of u.
+        [[nodiscard]] auto last() const noexcept -> ChunkType
+        {
+            return positive_carry - negative_carry - borrow;
+        }
+
+        bool u_positive;
+        ChunkType positive;
+        ChunkType negative;
+        ChunkType positive_carry{0};
+        ChunkType negative_carry{0};
+        ChunkType borrow{0};
+    };
+
+    // The next values of u and v are written to buffers reused by every step, and swapped with them.
+    DataType next_u;
+    DataType next_v;
+
+    auto apply = [&u, &v, &next_u, &next_v](EuclidMatrix const &m)
+    {
+        Row u_row(m.a, m.b);
+        Row v_row(m.c, m.d);
+        size_t const size = u.chunks.size();
+        next_u.resize(size + 1);
+        next_v.resize(size + 1);
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            ChunkType const v_chunk = i < v.chunks.size() ? v.chunks[i] : 0;
+            next_u[i] = u_row.next(u.chunks[i], v_chunk);
+            next_v[i] = v_row.next(u.chunks[i], v_chunk);
+        }
+
+        next_u[size] = u_row.last();
+        next_v[size] = v_row.last();
+
+        u.chunks.swap(next_u);
+        v.chunks.swap(next_v);
+        u.remove_leading_zeroes();
+        v.remove_leading_zeroes();
+    };
+
+    while (v.chunks.size() > 1)
+    {
+        size_t const shift = u.bit_count() - lehmer_bits;
+        auto const x = static_cast<SignedChunk>(bits_at(u.chunks, shift) & lehmer_mask);
+        auto const y = static_cast<SignedChunk>(bits_at(v.chunks, shift) & lehmer_mask);
+        EuclidMatrix const m = lehmer_matrix(x, y);
+
+        if (m.b == 0)
+        {
+            // The leading bits don't determine the quotient, do a full division step.
+            BigInt quotient;
+            BigInt remainder;
+            divide_magnitude(u.chunks, v.chunks, quotient.chunks, remainder.chunks);
+
+            if (cofactors != nullptr)
+            {
+                auto &[cu, cv] = *cofactors;
+                cu = std::exchange(cv, cu - (quotient * cv));
+            }
+
+            u = std::exchange(v, std::move(remainder));
+            continue;
+        }
+
+        if (cofactors != nullptr)
+        {
+            auto &[cu, cv] = *cofactors;
+            BigInt next_cu = (BigInt(m.a) * cu) + (BigInt(m.b) * cv);
+            cv = (BigInt(m.c) * cu) + (BigInt(m.d) * cv);
+            cu = std::move(next_cu);
+        }
+
+        apply(m);
+    }
+}
+
+namespace BI
+{
+auto gcd(BigIntView a, BigIntView b) -> BigInt
+{
+    if (BigInt::compare_magnitude(a.chunks(), b.chunks()) == std::strong_ordering::less)
+    {
+        std::swap(a, b);
+    }
+
+    if (b.is_zero())
+    {
+        return BigInt(a.abs());
+    }
+
+    BigInt u(a.abs());
+    BigInt v(b.abs());
+    BigInt::lehmer_reduce(u, v, nullptr);
+
+    if (v.is_zero())
+    {
+        return u;
+    }
+
+    // The smaller number fits in a chunk, a single chunk division reduces the larger one too.
+    ChunkType const remainder = BigInt::divide_by_chunk(u.chunks, v.chunks[0]);
+    return BigInt(BigInt::binary_gcd(v.chunks[0], remainder));
+}
+
+auto lcm(BigIntView a, BigIntView b) -> BigInt
+{
+    if (a.is_zero() || b.is_zero())
+    {
+        return BigInt{};
+    }
+
+    // Divide before multiplying to keep the intermediate result small.
+    return (a.abs() / gcd(a, b)) * b.abs();
+}
+
+auto gcdext(BigIntView a, BigIntView b) -> std::tuple<BigInt, BigInt, BigInt>
+{
+    if (a.is_zero() && b.is_zero())
+    {
+        return {BigInt(), BigInt(), BigInt()};
+    }
+
+    bool const swapped = BigInt::compare_magnitude(a.chunks(), b.chunks()) == std::strong_ordering::less;
+    BigIntView const larger = swapped ? b : a;
+    BigIntView const smaller = swapped ? a : b;
+
+    // Only the cofactors of the larger number are tracked, the other ones are found from the result.
+    BigInt u(larger.abs());
+    BigInt v(smaller.abs());
+    std::pair<BigInt, BigInt> cofactors{BigInt(1), BigInt()};
+    BigInt::lehmer_reduce(u, v, &cofactors);
+
+    while (!v.is_zero())
+    {
+        auto [quotient, remainder] = BigInt::div(u, v);
+        auto &[cu, cv] = cofactors;
+        cu = std::exchange(cv, cu - (quotient * cv));
+        u = std::exchange(v, std::move(remainder));
+    }
+
+    // g = s * |larger| + t * |smaller|.
+    BigInt s = std::move(cofactors.first);
+    BigInt t = smaller.is_zero() ? BigInt() : (u - (s * larger.abs())) / smaller.abs();
+
+    if (larger.is_negative())
+    {
+        s = -s;
+    }
+    if (smaller.is_negative())
+    {
+        t = -t;
+    }
+
+    if (swapped)
+    {
+        std::swap(s, t);
+    }
+
+    return {std::move(u), std::move(s), std::move(t)};
+}
+
+auto invert(BigIntView a, BigIntView modulus) -> BigInt
+{
+    if (modulus.is_zero())
+    {
+        throw std::domain_error("Modulus must not be 0");
+    }
+
+    BigIntView const m = modulus.abs();
+    auto [divisor, inverse, unused] = gcdext(a, m);
+
+    if (divisor != BigInt(1))
+    {
+        throw std::domain_error("Number is not invertible");
+    }
+
+    inverse = inverse % m;
+
+    if (inverse < BigInt())
+    {
+        inverse = inverse + m;
+    }
+
+    return inverse;
+}
+
+void batch_invert(std::span<BigInt> values, BigIntView modulus)
+{
+    if (modulus.is_zero())
+    {
+        throw std::domain_error("Modulus must not be 0");
+    }
+    if (values.empty())
+    {
+        return;
+    }
+
+    BigIntView const m = modulus.abs();
+
+    if ((m.chunks()[0] & 1) == 0 || m == BigInt(1))
+    {
+        montgomery_trick(
+            values,
+            m,
+            [&m](BigIntView value)
+            {
+                BigInt reduced = BigInt(value) % m;
+                return reduced < BigInt() ? reduced + m : reduced;
+            },
+            [&m](BigInt &lhs, BigInt const &rhs) { lhs = (lhs * rhs) % m; },
+            [](BigInt const &value) { return value; }
+        );
+        return;
+    }
+
+    detail::Montgomery const montgomery(m);
+    std::vector<ChunkType> scratch(montgomery.scratch_size());
+
+    montgomery_trick(
+        values,
+        m,
+        [&montgomery](BigIntView value)
+        {
+            std::vector<ChunkType> residue(montgomery.size());
+            montgomery.to_montgomery(value, residue);
+            return residue;
+        },
+        [&montgomery, &scratch](std::vector<ChunkType> &lhs, std::vector<ChunkType> const &rhs)
+        { montgomery.multiply(lhs, rhs, lhs, scratch); },
+        [&montgomery](std::vector<ChunkType> const &residue) { return montgomery.from_montgomery(residue); }
+    );
+}
+
+auto powm(BigIntView base, BigIntView exponent, BigIntView modulus) -> BigInt
+{
+    check_powm_arguments(exponent, modulus);
+
+    BigIntView const m = modulus.abs();
+
+    if (m == BigInt(1))
+    {
+        return BigInt{};
+    }
+    if (exponent.is_zero())
+    {
+        return BigInt(1);
+    }
+
+    if ((m.chunks()[0] & 1) == 0)
+    {
+        // Montgomery multiplication needs an odd modulus, reduce with a division after every multiplication instead.
+        BigInt reduced = BigInt(base) % m;
+
+        if (reduced < BigInt())
+        {
+            reduced = reduced + m;
+        }
+
+        return sliding_window_pow(
+            reduced, BigInt(1), exponent.chunks(), [&m](BigInt &lhs, BigInt const &rhs) { lhs = (lhs * rhs) % m; }
+        );
+    }
+
+    detail::Montgomery const montgomery(m);
+    std::vector<ChunkType> residue(montgomery.size());
+    std::vector<ChunkType> scratch(montgomery.scratch_size());
+    montgomery.to_montgomery(base, residue);
+
+    std::vector<ChunkType> const one(montgomery.one().begin(), montgomery.one().end());
+    std::vector<ChunkType> const result = sliding_window_pow(
+        residue,
+        one,
+        exponent.chunks(),
+        [&montgomery, &scratch](std::vector<ChunkType> &lhs, std::vector<ChunkType> const &rhs)
+        { montgomery.multiply(lhs, rhs, lhs, scratch); }
+    );
+
+    return montgomery.from_montgomery(result);
+}
+
+auto powm_sec(BigIntView base, BigIntView exponent, BigIntView modulus) -> BigInt
+{
+    check_powm_arguments(exponent, modulus);
+
+    BigIntView const m = modulus.abs();
+
+    if ((m.chunks()[0] & 1) == 0)
+    {
+        throw std::domain_error("Modulus must be odd");
+    }
+    if (m == BigInt(1))
+    {
+        return BigInt{};
+    }
+
+    // Fixed windows, every window does the same squarings and one multiplication even when its bits are 0.
+    constexpr size_t window = 4;
+    constexpr size_t table_size = static_cast<size_t>(1) << window;
+    static_assert(chunk_bits % window == 0, "Windows must not span two chunks");
+
+    detail::Montgomery const montgomery(m);
+    size_t const n = montgomery.size();
+    std::vector<ChunkType> scratch(montgomery.scratch_size());
+
+    // table[i] holds base^i, stored contiguously.
+    std::vector<ChunkType> table(table_size * n);
+    auto entry = [&table, n](size_t index) { return std::span(table).subspan(index * n, n); };
+
+    std::ranges::copy(montgomery.one(), entry(0).begin());
+    montgomery.to_montgomery(base, entry(1));
+
+    for (size_t i = 2; i < table_size; ++i)
+    {
+        montgomery.multiply(entry(i - 1), entry(1), entry(i), scratch);
+    }
+
+    std::vector<ChunkType> result(montgomery.one().begin(), montgomery.one().end());
+    std::vector<ChunkType> selected(n);
+    std::span<ChunkType const> const exponent_chunks = exponent.chunks();
+
+    for (size_t position = exponent_chunks.size() * chunk_bits; position > 0; position -= window)
+    {
+        for (size_t i = 0; i < window; ++i)
+        {
+            montgomery.multiply(result, result, result, scratch);
+        }
+
+        size_t const low_bit = position - window;
+        ChunkType const value = (exponent_chunks[low_bit / chunk_bits] >> (low_bit % chunk_bits)) & (table_size - 1);
+
+        // Read every entry of the table, so the memory accesses don't depend on the exponent.
+        std::ranges::fill(selected, 0);
+
+        for (size_t i = 0; i < table_size; ++i)
+        {
+            // All ones if i == value, computed without comparisons.
+            ChunkType const mask = 0 - (((static_cast<ChunkType>(i) ^ value) - 1) >> (chunk_bits - 1));
+
+            for (size_t j = 0; j < n; ++j)
+            {
+                selected[j] |= entry(i)[j] & mask;
+            }
+        }
+
+        montgomery.multiply(result, selected, result, scratch);
+    }
+
+    return montgomery.from_montgomery(result);
+}
+}  // namespace BI
@@ -0,0 +1,189 @@
+#include "bigint/power_cache.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+using namespace BI;
+
+namespace
+{
+using ChunkType = BigInt::ChunkType;
+
+/// @brief Powers with fewer bits are computed directly instead of from the cached power of half the exponent.
+constexpr size_t direct_bits = 256;
+
+class PowerCache
+{
+public:
+    static auto get() -> PowerCache &
+    {
+        static PowerCache cache;
+        return cache;
+    }
+
+    [[nodiscard]] auto find(ChunkType base, size_t exponent) -> std::optional<SharedBigInt>
+    {
+        std::scoped_lock const lock(mutex);
+        auto const it = entries.find({base, exponent});
+
+        if (it == entries.end())
+        {
+            return std::nullopt;
+        }
+
+        it->second.last_use = ++clock;
+        return it->second.value;
+    }
+
+    /// @brief Add a power, unless another thread added it first or it's larger than the limit.
+    ///
+    /// @return The cached power.
+    auto insert(ChunkType base, size_t exponent, SharedBigInt value) -> SharedBigInt
+    {
+        size_t const bytes = BigIntView(value).chunks().size_bytes();
+        std::scoped_lock const lock(mutex);
+
+        if (auto const it = entries.find({base, exponent}); it != entries.end())
+        {
+            it->second.last_use = ++clock;
+            return it->second.value;
+        }
+
+        if (bytes > limit)
+        {
+            return value;
+        }
+
+        evict(limit - bytes);
+        usage += bytes;
+        entries.emplace(Key{base, exponent}, Entry{.value = value, .bytes = bytes, .last_use = ++clock});
+        return value;
+    }
+
+    [[nodiscard]] auto get_limit() -> size_t
+    {
+        std::scoped_lock const lock(mutex);
+        return limit;
+    }
+
+    void set_limit(size_t bytes)
+    {
+        std::scoped_lock const lock(mutex);
+        limit = bytes;
+        evict(limit);
+    }
+
+    [[nodiscard]] auto get_usage() -> size_t
+    {
+        std::scoped_lock const lock(mutex);
+        return usage;
+    }
+
+    void clear()
+    {
+        std::scoped_lock const lock(mutex);
+        entries.clear();
+        usage = 0;
+    }
+
+private:
+    using Key = std::pair<ChunkType, size_t>;
+
+    struct Entry
+    {
+        SharedBigInt value;
+        size_t bytes;
+        std::uint64_t last_use;
+    };
+
+    std::mutex mutex;
+    std::map<Key, Entry> entries;
+    size_t limit{default_power_cache_limit};
+    size_t usage{0};
+    /// @brief Incremented on every use, orders the entries by their last use.
+    std::uint64_t clock{0};
+
+    /// @brief Drop the least recently used entries until the usage is at most the given number of bytes.
+    void evict(size_t bytes)
+    {
+        while (usage > bytes)
+        {
+            auto const oldest = std::ranges::min_element(
+                entries,
+                {},
+                [](std::pair<Key const, Entry> const &entry) { return entry.second.last_use; }
+            );
+            usage -= oldest->second.bytes;
+            entries.erase(oldest);
+        }
+    }
+};
+
+/// @brief Compute a power, using the cache for the power of half the exponent.
+auto compute_power(ChunkType base, size_t exponent) -> BigInt
+{
+    if (std::has_single_bit(base))
+    {
+        return BigInt(1) << (exponent * static_cast<size_t>(std::countr_zero(base)));
+    }
+
+    if (exponent * static_cast<size_t>(std::bit_width(base)) <= direct_bits)
+    {
+        return BigInt(base).pow(exponent);
+    }
+
+    if (exponent % 2 == 1)
+    {
+        return BigIntView(cached_power(base, exponent - 1)) * BigInt(base);
+    }
+
+    SharedBigInt const half = cached_power(base, exponent / 2);
+    return BigIntView(half) * BigIntView(half);
+}
+}  // namespace
+
+namespace BI
+{
+auto cached_power(ChunkType base, size_t exponent) -> SharedBigInt
+{
+    if (base < 2)
+    {
+        throw std::invalid_argument("Base of a cached power must be at least 2");
+    }
+
+    PowerCache &cache = PowerCache::get();
+
+    if (std::optional<SharedBigInt> cached = cache.find(base, exponent))
+    {
+        return *std::move(cached);
+    }
+
+    return cache.insert(base, exponent, SharedBigInt(compute_power(base, exponent)));
+}
+
+auto get_power_cache_limit() -> size_t
+{
+    return PowerCache::get().get_limit();
+}
+
+void set_power_cache_limit(size_t bytes)
+{
+    PowerCache::get().set_limit(bytes);
+}
+
+auto get_power_cache_usage() -> size_t
+{
+    return PowerCache::get().get_usage();
+}
+
+void clear_power_cache()
+{
+    PowerCache::get().clear();
+}
+}  // namespace BI
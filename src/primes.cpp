@@ -0,0 +1,502 @@
+#include "bigint/bigint.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "bigint/montgomery.hpp"
+#include "chunk_arithmetic.hpp"
+
+using namespace BI;
+using namespace BI::detail;
+
+namespace
+{
+using ChunkType = BigInt::ChunkType;
+
+/// @brief The sieve primes are the odd primes below this limit.
+constexpr std::uint32_t sieve_limit = static_cast<std::uint32_t>(1) << 16;
+
+/// @brief Trial division before a primality test uses the odd primes below this limit, more would cost more than the
+/// exponentiations they save.
+constexpr std::uint32_t trial_limit = static_cast<std::uint32_t>(1) << 10;
+
+/// @brief Number of odd candidates sieved at once by next_prime(), enough to contain a prime most of the time for
+/// numbers of a few thousand bits.
+constexpr size_t sieve_window = static_cast<size_t>(1) << 12;
+
+/// @brief Consecutive primes whose product fits in 32 bits, so a single remainder gives the remainders of all of them.
+struct PrimeGroup
+{
+    std::uint64_t product;
+    size_t first;
+    size_t last;
+};
+
+struct SmallPrimes
+{
+    /// @brief Odd primes below sieve_limit, in increasing order.
+    std::vector<std::uint32_t> primes;
+    /// @brief Groups of consecutive primes covering all of them.
+    std::vector<PrimeGroup> groups;
+    /// @brief Number of groups covering the primes below trial_limit.
+    size_t trial_groups{};
+};
+
+/// @brief Get the small primes, computed with a sieve of Eratosthenes on first use.
+auto small_primes() -> SmallPrimes const &
+{
+    static SmallPrimes const small = []
+    {
+        SmallPrimes result;
+        std::vector<bool> composite(sieve_limit);
+
+        for (std::uint32_t i = 3; i < sieve_limit; i += 2)
+        {
+            if (composite[i])
+            {
+                continue;
+            }
+
+            result.primes.push_back(i);
+
+            for (std::uint32_t j = i * i; j < sieve_limit; j += 2 * i)
+            {
+                composite[j] = true;
+            }
+        }
+
+        constexpr std::uint64_t max_product = std::uint64_t{1} << 32;
+
+        for (size_t i = 0; i < result.primes.size();)
+        {
+            PrimeGroup group{1, i, i};
+
+            while (group.last < result.primes.size() && group.product * result.primes[group.last] < max_product)
+            {
+                group.product *= result.primes[group.last++];
+            }
+
+            if (result.primes[group.first] < trial_limit)
+            {
+                ++result.trial_groups;
+            }
+
+            result.groups.push_back(group);
+            i = group.last;
+        }
+
+        return result;
+    }();
+
+    return small;
+}
+
+/// @brief Get the remainders of a magnitude divided by the primes of some groups.
+///
+/// All the groups are reduced in a single pass over the chunks, 32 bits at a time. Every group only needs one division
+/// per 32 bits, and the remainders of its primes are taken from the remainder of the group at the end.
+///
+/// @param chunks The magnitude.
+/// @param groups Consecutive groups, starting with the first prime.
+/// @param[out] remainders The remainder for every prime covered by the groups.
+void small_remainders(
+    std::span<ChunkType const> chunks, std::span<PrimeGroup const> groups, std::span<std::uint32_t> remainders
+)
+{
+    constexpr size_t piece_bits = 32;
+    std::vector<std::uint64_t> group_remainders(groups.size());
+
+    for (auto it = chunks.rbegin(); it != chunks.rend(); ++it)
+    {
+        for (size_t shift = chunk_bits; shift > 0; shift -= piece_bits)
+        {
+            auto const piece = static_cast<std::uint64_t>((*it >> (shift - piece_bits)) & 0xFFFFFFFF);
+
+            for (size_t i = 0; i < groups.size(); ++i)
+            {
+                group_remainders[i] = ((group_remainders[i] << piece_bits) | piece) % groups[i].product;
+            }
+        }
+    }
+
+    std::span<std::uint32_t const> const primes = small_primes().primes;
+
+    for (size_t i = 0; i < groups.size(); ++i)
+    {
+        for (size_t j = groups[i].first; j < groups[i].last; ++j)
+        {
+            remainders[j] = static_cast<std::uint32_t>(group_remainders[i] % primes[j]);
+        }
+    }
+}
+
+/// @brief Get the Jacobi symbol (a / n) of two small numbers, n must be odd.
+constexpr auto jacobi(std::uint64_t a, std::uint64_t n) noexcept -> int
+{
+    int result = 1;
+    a %= n;
+
+    while (a != 0)
+    {
+        while (a % 2 == 0)
+        {
+            a /= 2;
+
+            if (n % 8 == 3 || n % 8 == 5)
+            {
+                result = -result;
+            }
+        }
+
+        std::swap(a, n);
+
+        if (a % 4 == 3 && n % 4 == 3)
+        {
+            result = -result;
+        }
+
+        a %= n;
+    }
+
+    return n == 1 ? result : 0;
+}
+
+/// @brief Get the Jacobi symbol (a / n) of a small number and an odd magnitude.
+auto jacobi(std::int64_t a, std::span<ChunkType const> n) noexcept -> int
+{
+    int result = 1;
+    auto const n_mod_8 = static_cast<std::uint64_t>(n[0] & 7);
+    auto a_magnitude = static_cast<std::uint64_t>(a < 0 ? -a : a);
+
+    // (-1 / n) = -1 if n = 3 mod 4.
+    if (a < 0 && n_mod_8 % 4 == 3)
+    {
+        result = -result;
+    }
+
+    // (2 / n) = -1 if n = 3 or 5 mod 8.
+    while (a_magnitude % 2 == 0)
+    {
+        a_magnitude /= 2;
+
+        if (n_mod_8 == 3 || n_mod_8 == 5)
+        {
+            result = -result;
+        }
+    }
+
+    // Quadratic reciprocity turns the symbol into one of small numbers.
+    if (a_magnitude % 4 == 3 && n_mod_8 % 4 == 3)
+    {
+        result = -result;
+    }
+
+    return result * jacobi(remainder(n, a_magnitude), a_magnitude);
+}
+
+/// @brief Miller-Rabin test of an odd number to a single base.
+///
+/// @param n The number to test, odd and greater than 3.
+/// @param odd_part The odd part of n - 1.
+/// @param twos The exponent of 2 in n - 1.
+/// @param base The base, in [2, n - 2].
+/// @return false if n is certainly composite.
+auto strong_probable_prime(BigInt const &n, BigInt const &odd_part, size_t twos, BigIntView base) -> bool
+{
+    BigInt const n_minus_one = n - BigInt(1);
+    BigInt x = powm(base, odd_part, n);
+
+    if (x == BigInt(1) || x == n_minus_one)
+    {
+        return true;
+    }
+
+    for (size_t i = 1; i < twos; ++i)
+    {
+        x = (x * x) % n;
+
+        if (x == n_minus_one)
+        {
+            return true;
+        }
+        if (x == BigInt(1))
+        {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+/// @brief Strong Lucas test with the parameters of Selfridge's method A.
+///
+/// D is the first of 5, -7, 9, -11, ... such that (D / n) = -1, P = 1 and Q = (1 - D) / 4. The sequences are computed
+/// in Montgomery form with the doubling formulas, halving modulo n is adding n if needed and shifting.
+///
+/// @param n The number to test, odd and without small factors.
+/// @return false if n is certainly composite.
+auto strong_lucas_probable_prime(BigInt const &n) -> bool
+{
+    // No D exists for squares.
+    if (is_perfect_square(n))
+    {
+        return false;
+    }
+
+    std::span<ChunkType const> const n_chunks = BigIntView(n).chunks();
+    std::int64_t d = 5;
+
+    while (true)
+    {
+        int const symbol = jacobi(d, n_chunks);
+
+        if (symbol == -1)
+        {
+            break;
+        }
+        // n has no small factors, so it isn't |D| and D has a common factor with it.
+        if (symbol == 0)
+        {
+            return false;
+        }
+
+        d = d > 0 ? -(d + 2) : -(d - 2);
+    }
+
+    detail::Montgomery const montgomery(n);
+    size_t const size = montgomery.size();
+    std::vector<ChunkType> scratch(montgomery.scratch_size());
+
+    auto residue = [&montgomery, size](std::int64_t value)
+    {
+        std::vector<ChunkType> result(size);
+        montgomery.to_montgomery(BigInt(value), result);
+        return result;
+    };
+    auto multiply = [&montgomery, &scratch](std::span<ChunkType const> lhs, std::span<ChunkType const> rhs,
+                                            std::span<ChunkType> result)
+    { montgomery.multiply(lhs, rhs, result, scratch); };
+    auto half = [&montgomery, size](std::span<ChunkType> value)
+    {
+        std::span<ChunkType const> const modulus = montgomery.get_modulus();
+        ChunkType const mask = 0 - (value[0] & 1);
+        ChunkType carry = 0;
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            ChunkType const addend = modulus[i] & mask;
+            ChunkType const sum = value[i] + addend;
+            ChunkType const overflow = static_cast<ChunkType>(sum < addend);
+            value[i] = sum + carry;
+            carry = overflow | static_cast<ChunkType>(value[i] < carry);
+        }
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            ChunkType const next = i + 1 < size ? value[i + 1] : carry;
+            value[i] = (value[i] >> 1) | (next << (chunk_bits - 1));
+        }
+    };
+    auto is_zero = [](std::span<ChunkType const> value)
+    { return std::ranges::all_of(value, [](ChunkType chunk) { return chunk == 0; }); };
+
+    std::vector<ChunkType> const d_residue = residue(d);
+    std::vector<ChunkType> const q_residue = residue((1 - d) / 4);
+
+    // n + 1 = odd_part * 2^twos.
+    BigInt const n_plus_one = n + BigInt(1);
+    size_t const twos = trailing_zeroes(BigIntView(n_plus_one).chunks());
+    BigInt const odd_part = n_plus_one >> twos;
+    std::span<ChunkType const> const odd_chunks = BigIntView(odd_part).chunks();
+
+    // U_1 = 1, V_1 = P = 1 and Q^1.
+    std::vector<ChunkType> u(montgomery.one().begin(), montgomery.one().end());
+    std::vector<ChunkType> v = u;
+    std::vector<ChunkType> q_power = q_residue;
+    std::vector<ChunkType> temp(size);
+
+    for (size_t i = bit_length(odd_chunks) - 1; i-- > 0;)
+    {
+        // U_2k = U_k * V_k, V_2k = V_k^2 - 2 * Q^k.
+        multiply(u, v, u);
+        multiply(v, v, v);
+        montgomery.subtract(v, q_power, v);
+        montgomery.subtract(v, q_power, v);
+        multiply(q_power, q_power, q_power);
+
+        if (((odd_chunks[i / chunk_bits] >> (i % chunk_bits)) & 1) != 0)
+        {
+            // U_2k+1 = (U_2k + V_2k) / 2, V_2k+1 = (D * U_2k + V_2k) / 2.
+            multiply(d_residue, u, temp);
+            montgomery.add(u, v, u);
+            half(u);
+            montgomery.add(temp, v, v);
+            half(v);
+            multiply(q_power, q_residue, q_power);
+        }
+    }
+
+    if (is_zero(u) || is_zero(v))
+    {
+        return true;
+    }
+
+    // V_2^r*d for 0 < r < twos.
+    for (size_t r = 1; r < twos; ++r)
+    {
+        multiply(v, v, v);
+        montgomery.subtract(v, q_power, v);
+        montgomery.subtract(v, q_power, v);
+
+        if (is_zero(v))
+        {
+            return true;
+        }
+
+        multiply(q_power, q_power, q_power);
+    }
+
+    return false;
+}
+
+/// @brief Baillie-PSW test followed by Miller-Rabin tests to random bases.
+///
+/// @param n The number to test, odd and without small factors.
+/// @param rounds Number of Miller-Rabin tests to random bases.
+auto baillie_psw(BigInt const &n, size_t rounds) -> bool
+{
+    BigInt const n_minus_one = n - BigInt(1);
+    size_t const twos = trailing_zeroes(BigIntView(n_minus_one).chunks());
+    BigInt const odd_part = n_minus_one >> twos;
+
+    if (!strong_probable_prime(n, odd_part, twos, BigInt(2)) || !strong_lucas_probable_prime(n))
+    {
+        return false;
+    }
+
+    thread_local std::mt19937_64 engine{std::random_device{}()};
+    std::vector<ChunkType> random_chunks(BigIntView(n).chunks().size());
+    BigInt const base_range = n - BigInt(3);
+
+    for (size_t i = 0; i < rounds; ++i)
+    {
+        std::ranges::generate(random_chunks, [] { return static_cast<ChunkType>(engine()); });
+
+        // A base in [2, n - 2].
+        BigInt const base = (BigInt(BigIntView(random_chunks)) % base_range) + BigInt(2);
+
+        if (!strong_probable_prime(n, odd_part, twos, base))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+}  // namespace
+
+namespace BI
+{
+auto is_probable_prime(BigIntView num, size_t rounds) -> bool
+{
+    if (num.is_negative() || num.is_zero())
+    {
+        return false;
+    }
+
+    SmallPrimes const &small = small_primes();
+    std::span<ChunkType const> const chunks = num.chunks();
+
+    if (chunks.size() == 1 && chunks[0] < sieve_limit)
+    {
+        return chunks[0] == 2 || std::ranges::binary_search(small.primes, static_cast<std::uint32_t>(chunks[0]));
+    }
+    if ((chunks[0] & 1) == 0)
+    {
+        return false;
+    }
+
+    std::span<PrimeGroup const> const trial_groups = std::span(small.groups).first(small.trial_groups);
+    std::vector<std::uint32_t> remainders(trial_groups.back().last);
+    small_remainders(chunks, trial_groups, remainders);
+
+    if (std::ranges::find(remainders, 0) != remainders.end())
+    {
+        return false;
+    }
+
+    // A composite number without factors below trial_limit is at least trial_limit^2.
+    if (bit_length(chunks) <= 2 * static_cast<size_t>(std::countr_zero(trial_limit)))
+    {
+        return true;
+    }
+
+    return baillie_psw(BigInt(num), rounds);
+}
+
+auto next_prime(BigIntView num) -> BigInt
+{
+    SmallPrimes const &small = small_primes();
+
+    if (num < BigInt(2))
+    {
+        return BigInt(2);
+    }
+    if (num < BigInt(small.primes.back()))
+    {
+        return BigInt(*std::ranges::upper_bound(small.primes, static_cast<std::uint32_t>(num.chunks()[0])));
+    }
+
+    // Sieve windows of odd candidates start + 2i with the small primes, which are all smaller than the candidates, and
+    // only test the candidates without small factors. The remainders of start are computed once and then updated.
+    BigInt start = BigInt(num) + BigInt(1);
+
+    if ((BigIntView(start).chunks()[0] & 1) == 0)
+    {
+        start += BigInt(1);
+    }
+
+    std::vector<std::uint32_t> remainders(small.primes.size());
+    small_remainders(BigIntView(start).chunks(), small.groups, remainders);
+    std::vector<bool> composite(sieve_window);
+
+    while (true)
+    {
+        composite.assign(sieve_window, false);
+
+        for (size_t j = 0; j < small.primes.size(); ++j)
+        {
+            // start + 2i = 0 mod p when i = -remainder / 2 mod p, and (p + 1) / 2 is the inverse of 2.
+            std::uint64_t const p = small.primes[j];
+
+            for (std::uint64_t i = ((p - remainders[j]) % p) * ((p + 1) / 2) % p; i < sieve_window; i += p)
+            {
+                composite[i] = true;
+            }
+
+            remainders[j] = static_cast<std::uint32_t>((remainders[j] + (2 * sieve_window)) % p);
+        }
+
+        for (size_t i = 0; i < sieve_window; ++i)
+        {
+            if (composite[i])
+            {
+                continue;
+            }
+
+            BigInt candidate = start + BigInt(2 * i);
+
+            if (baillie_psw(candidate, 0))
+            {
+                return candidate;
+            }
+        }
+
+        start += BigInt(2 * sieve_window);
+    }
+}
+}  // namespace BI
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+
+namespace BI::detail
+{
+/// @brief Smallest base supported by conversions.
+constexpr int min_base = 2;
+/// @brief Largest base supported by conversions.
+constexpr int max_base = 36;
+
+/// @brief Number of digits of a base that fit in a chunk, and the base raised to that number (the "big base").
+template<std::unsigned_integral T>
+struct RadixInfo
+{
+    size_t digits_per_chunk;
+    T big_base;
+};
+
+/// @brief Compute the radix info of every supported base. Entries for bases 0 and 1 are unused.
+template<std::unsigned_integral T>
+constexpr auto make_radix_table()
+{
+    std::array<RadixInfo<T>, max_base + 1> table{};
+
+    for (T base = min_base; base < table.size(); ++base)
+    {
+        RadixInfo<T> info{.digits_per_chunk = 1, .big_base = base};
+
+        while (info.big_base <= std::numeric_limits<T>::max() / base)
+        {
+            info.big_base *= base;
+            ++info.digits_per_chunk;
+        }
+
+        table[base] = info;
+    }
+
+    return table;
+}
+
+template<std::unsigned_integral T>
+inline constexpr auto radix_table = make_radix_table<T>();
+
+/// @brief Check that a base is supported by conversions.
+///
+/// @throws std::invalid_argument if the base is out of range.
+void check_base(int base);
+}  // namespace BI::detail
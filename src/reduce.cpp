@@ -0,0 +1,133 @@
+#include "bigint/accumulator.hpp"
+#include "bigint/bigint.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include "thread_pool.hpp"
+
+using namespace BI;
+
+namespace
+{
+/// @brief Get the number of tasks to split a reduction into.
+auto task_count(std::span<BigInt const> values, ExecutionPolicy const &policy) -> size_t
+{
+    if (policy.threads == 1)
+    {
+        return 1;
+    }
+
+    size_t chunks = 0;
+
+    for (BigInt const &value : values)
+    {
+        chunks += BigIntView(value).chunks().size();
+    }
+
+    return policy.is_parallel(chunks) ? detail::ThreadPool::resolve_threads(policy.threads) : 1;
+}
+
+/// @brief Run tasks(i) for every i in [0, count) on the pool of a policy, or on the calling thread if count is 1.
+void run_tasks(size_t count, ExecutionPolicy const &policy, std::function<void(size_t)> const &task)
+{
+    if (count == 1)
+    {
+        task(0);
+        return;
+    }
+
+    std::vector<std::function<void()>> functions;
+    functions.reserve(count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        functions.emplace_back([&task, i] { task(i); });
+    }
+
+    detail::ThreadPool::get(policy.threads).run(functions, policy.threads);
+}
+}  // namespace
+
+namespace BI
+{
+auto reduce_product(std::span<BigInt const> values, ExecutionPolicy const &policy) -> BigInt
+{
+    if (values.empty())
+    {
+        return BigInt(1);
+    }
+    if (std::ranges::any_of(values, [](BigInt const &value) { return BigIntView(value).is_zero(); }))
+    {
+        return BigInt();
+    }
+
+    size_t const tasks = task_count(values, policy);
+    std::vector<BigIntView> level(values.begin(), values.end());
+    std::vector<BigInt> products;
+
+    while (level.size() > 1)
+    {
+        // Neighbours have about the same size once sorted, the largest number is left over when the count is odd.
+        std::ranges::stable_sort(level, {}, [](BigIntView value) { return value.chunks().size(); });
+
+        size_t const pairs = level.size() / 2;
+        std::vector<BigInt> next(pairs);
+
+        // Every task takes every tasks-th pair, so the large products at the end are spread over all of them. Once
+        // there are fewer pairs than threads, the products themselves are parallel.
+        run_tasks(
+            std::min(tasks, pairs),
+            policy,
+            [&](size_t task)
+            {
+                for (size_t i = task; i < pairs; i += tasks)
+                {
+                    next[i] = multiply(level[2 * i], level[(2 * i) + 1], policy);
+                }
+            }
+        );
+
+        if (level.size() % 2 == 1)
+        {
+            next.emplace_back(level.back());
+        }
+
+        products = std::move(next);
+        level.assign(products.begin(), products.end());
+    }
+
+    return products.empty() ? BigInt(values.front()) : std::move(products.front());
+}
+
+auto reduce_sum(std::span<BigInt const> values, ExecutionPolicy const &policy) -> BigInt
+{
+    size_t const tasks = std::max(std::min(task_count(values, policy), values.size()), size_t{1});
+
+    std::vector<Accumulator> sums(tasks);
+
+    // Every task sums a contiguous block of the values.
+    run_tasks(
+        tasks,
+        policy,
+        [&](size_t task)
+        {
+            size_t const first = values.size() * task / tasks;
+            size_t const last = values.size() * (task + 1) / tasks;
+
+            for (BigInt const &value : values.subspan(first, last - first))
+            {
+                sums[task] += value;
+            }
+        }
+    );
+
+    for (size_t i = 1; i < tasks; ++i)
+    {
+        sums.front().merge(sums[i]);
+    }
+
+    return sums.front().result();
+}
+}  // namespace BI
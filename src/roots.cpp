@@ -0,0 +1,264 @@
+#include "bigint/bigint.hpp"
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include "chunk_arithmetic.hpp"
+
+using namespace BI;
+using namespace BI::detail;
+
+namespace
+{
+using ChunkType = BigInt::ChunkType;
+
+/// @brief Largest number of bits of a root that is computed directly from a double.
+constexpr size_t direct_root_bits = 32;
+
+/// @brief Get a table of the squares modulo a number, table[r] is set if r is a square modulo Modulus.
+template<size_t Modulus>
+constexpr auto square_residues() noexcept -> std::array<bool, Modulus>
+{
+    std::array<bool, Modulus> table{};
+
+    for (size_t i = 0; i < Modulus; ++i)
+    {
+        table[(i * i) % Modulus] = true;
+    }
+
+    return table;
+}
+
+/// @brief Check if a number is prime by trial division, only meant for small numbers.
+constexpr auto is_small_prime(std::uint64_t num) noexcept -> bool
+{
+    if (num < 4)
+    {
+        return num >= 2;
+    }
+    if (num % 2 == 0)
+    {
+        return false;
+    }
+
+    for (std::uint64_t divisor = 3; divisor * divisor <= num; divisor += 2)
+    {
+        if (num % divisor == 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// @brief Check if a magnitude may be a k-th power for an odd prime k, with the residues modulo primes q = 1 mod k.
+///
+/// Only (q - 1) / k + 1 of the q residues are k-th powers, so a few primes reject almost every number that isn't.
+///
+/// @return false if the magnitude is certainly not a k-th power.
+auto may_be_power(std::span<ChunkType const> chunks, size_t k) noexcept -> bool
+{
+    constexpr size_t filter_primes = 3;
+    constexpr std::uint64_t max_filter_prime = std::uint64_t{1} << 32;
+    size_t tested = 0;
+
+    // k is odd, so q = 1 + j * k is odd when j is even.
+    for (std::uint64_t q = 1 + (2 * static_cast<std::uint64_t>(k)); tested < filter_primes && q < max_filter_prime;
+         q += 2 * static_cast<std::uint64_t>(k))
+    {
+        if (!is_small_prime(q))
+        {
+            continue;
+        }
+
+        ++tested;
+        std::uint64_t const residue = remainder(chunks, q);
+
+        // Euler's criterion for k-th powers, r^((q - 1) / k) = 1 mod q.
+        if (residue != 0 && pow_mod(residue, (q - 1) / k, q) != 1)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// @brief Get the k-th root of a positive number rounded down with Newton's method.
+///
+/// The root of the number without its lowest k * shift bits is computed recursively and gives the first half of the
+/// bits of the root, so the final Newton iterations start close to the root and only a couple of them run at full
+/// precision. Roots of up to direct_root_bits bits are computed directly from a double.
+///
+/// @param num The number, must be positive.
+/// @param k The degree of the root, at least 2.
+auto newton_root(BigIntView num, size_t k) -> BigInt
+{
+    std::span<ChunkType const> const chunks = num.chunks();
+    size_t const bits = bit_length(chunks);
+    BigInt const one(1);
+
+    if ((bits + k - 1) / k <= direct_root_bits)
+    {
+        // log2(num) from its leading bits, the estimate is within a few units of the root.
+        size_t const low = bits > chunk_bits ? bits - chunk_bits : 0;
+        double const log2_num = std::log2(static_cast<double>(bits_at(chunks, low))) + static_cast<double>(low);
+        BigInt result(static_cast<std::uint64_t>(std::exp2(log2_num / static_cast<double>(k))));
+
+        while (BigIntView(result.pow(k)) > num)
+        {
+            result -= one;
+        }
+        while (BigIntView((result + one).pow(k)) <= num)
+        {
+            result += one;
+        }
+
+        return result;
+    }
+
+    // ((r + 1) << shift)^k is larger than num, so Newton's method decreases towards the root from there.
+    size_t const shift = bits / (2 * k);
+    BigInt const value(num);
+    BigInt root = (newton_root(value >> (k * shift), k) + one) << shift;
+    BigInt const degree(k);
+    BigInt const degree_minus_one(k - 1);
+
+    while (true)
+    {
+        BigInt next = ((root * degree_minus_one) + (value / root.pow(k - 1))) / degree;
+
+        if (next >= root)
+        {
+            return root;
+        }
+
+        root = std::move(next);
+    }
+}
+}  // namespace
+
+namespace BI
+{
+auto isqrt(BigIntView num) -> BigInt
+{
+    if (num.is_negative())
+    {
+        throw std::domain_error("Square root of a negative number");
+    }
+
+    return num.is_zero() ? BigInt() : newton_root(num, 2);
+}
+
+auto sqrtrem(BigIntView num) -> std::pair<BigInt, BigInt>
+{
+    BigInt square_root = isqrt(num);
+    BigInt rest = BigInt(num) - (square_root * square_root);
+    return {std::move(square_root), std::move(rest)};
+}
+
+auto root(BigIntView num, size_t k) -> BigInt
+{
+    if (k == 0)
+    {
+        throw std::domain_error("Root of degree 0");
+    }
+    if (num.is_negative() && k % 2 == 0)
+    {
+        throw std::domain_error("Even root of a negative number");
+    }
+
+    if (k == 1 || num.is_zero())
+    {
+        return BigInt(num);
+    }
+
+    BigInt result = newton_root(num.abs(), k);
+    return num.is_negative() ? -result : result;
+}
+
+auto is_perfect_square(BigIntView num) -> bool
+{
+    if (num.is_negative())
+    {
+        return false;
+    }
+    if (num.is_zero())
+    {
+        return true;
+    }
+
+    // Only 12 of the 64 residues modulo 64 are squares, and about 1 in 6 numbers pass the filters modulo 63, 65 and
+    // 11, which are computed from a single remainder.
+    static constexpr auto residues_64 = square_residues<64>();
+    static constexpr auto residues_63 = square_residues<63>();
+    static constexpr auto residues_65 = square_residues<65>();
+    static constexpr auto residues_11 = square_residues<11>();
+
+    std::span<ChunkType const> const chunks = num.chunks();
+
+    if (!residues_64[chunks[0] % 64])
+    {
+        return false;
+    }
+
+    std::uint64_t const residue = remainder(chunks, std::uint64_t{63} * 65 * 11);
+
+    if (!residues_63[residue % 63] || !residues_65[residue % 65] || !residues_11[residue % 11])
+    {
+        return false;
+    }
+
+    auto const [square_root, rest] = sqrtrem(num);
+    return rest == BigInt();
+}
+
+auto is_perfect_power(BigIntView num) -> bool
+{
+    BigIntView const magnitude = num.abs();
+
+    // 0 = 0^2, 1 = 1^2 and -1 = (-1)^3.
+    if (magnitude.is_zero() || magnitude == BigInt(1))
+    {
+        return true;
+    }
+
+    std::span<ChunkType const> const chunks = magnitude.chunks();
+    size_t const bits = bit_length(chunks);
+
+    // If num = a^k, k divides the exponent of every prime factor of num, in particular the exponent of 2.
+    size_t const twos = trailing_zeroes(chunks);
+
+    // It's enough to check prime degrees, and the root is at least 2 so 2^k <= num.
+    for (size_t k = 2; k < bits; ++k)
+    {
+        if (!is_small_prime(k) || (twos != 0 && twos % k != 0))
+        {
+            continue;
+        }
+
+        if (k == 2)
+        {
+            // Negative numbers are never even powers.
+            if (!num.is_negative() && is_perfect_square(magnitude))
+            {
+                return true;
+            }
+
+            continue;
+        }
+
+        if (may_be_power(chunks, k) && BigIntView(newton_root(magnitude, k).pow(k)) == magnitude)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+}  // namespace BI
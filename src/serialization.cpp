@@ -0,0 +1,339 @@
+#include "bigint/bigint.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+using namespace BI;
+using namespace BI::detail;
+
+namespace
+{
+// Mixed-endian platforms are not supported.
+static_assert(std::endian::native == std::endian::little || std::endian::native == std::endian::big);
+
+/// @brief Bit of the most significant byte that holds the sign.
+constexpr auto sign_bit = std::byte{0x80};
+
+/// @brief Maximum number of bytes of an unsigned 64-bit LEB128 value.
+constexpr size_t max_leb128_size = 10;
+
+/// @brief Number of bytes needed to store a magnitude, 0 for 0.
+auto magnitude_size(std::span<BigInt::ChunkType const> chunks) noexcept -> size_t
+{
+    if (chunks.empty() || (chunks.size() == 1 && chunks[0] == 0))
+    {
+        return 0;
+    }
+
+    constexpr size_t chunk_bits = sizeof(BigInt::ChunkType) * 8;
+    auto const leading_zeroes = static_cast<size_t>(std::countl_zero(chunks.back()));
+    return ((chunks.size() * chunk_bits) - leading_zeroes + 7) / 8;
+}
+
+/// @brief Write the least significant bytes of a magnitude in little endian.
+///
+/// @param chunks Chunks of the magnitude in little endian.
+/// @param[out] bytes The buffer to write to, must not be larger than the chunks.
+void write_magnitude(std::span<BigInt::ChunkType const> chunks, std::span<std::byte> bytes) noexcept
+{
+    if constexpr (std::endian::native == std::endian::little)
+    {
+        std::memcpy(bytes.data(), chunks.data(), bytes.size());
+    }
+    else
+    {
+        constexpr size_t chunk_bytes = sizeof(BigInt::ChunkType);
+
+        for (size_t i = 0; i < bytes.size(); i += chunk_bytes)
+        {
+            BigInt::ChunkType const chunk = std::byteswap(chunks[i / chunk_bytes]);
+            std::memcpy(&bytes[i], &chunk, std::min(chunk_bytes, bytes.size() - i));
+        }
+    }
+}
+
+/// @brief Get the number of bytes of a value in unsigned LEB128.
+constexpr auto leb128_size(std::uint64_t value) noexcept -> size_t
+{
+    return std::max<size_t>((static_cast<size_t>(std::bit_width(value)) + 6) / 7, 1);
+}
+
+/// @brief Write a value in unsigned LEB128.
+///
+/// @return The number of bytes written.
+auto write_leb128(std::uint64_t value, std::byte *output) noexcept -> size_t
+{
+    size_t size = 0;
+
+    // 7 bits per byte, least significant first, the highest bit is set on every byte except the last one.
+    while (value >= 0x80)
+    {
+        output[size++] = static_cast<std::byte>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+
+    output[size++] = static_cast<std::byte>(value);
+    return size;
+}
+
+/// @brief Read a value in unsigned LEB128 and move the position past it.
+///
+/// @throws std::invalid_argument if the value is truncated or doesn't fit in 64 bits.
+auto read_leb128(std::span<std::byte const> bytes, size_t &position) -> std::uint64_t
+{
+    std::uint64_t value = 0;
+
+    for (size_t i = 0; i < max_leb128_size; ++i)
+    {
+        if (position >= bytes.size())
+        {
+            throw std::invalid_argument("Compact encoding is truncated");
+        }
+
+        auto const byte = std::to_integer<std::uint64_t>(bytes[position++]);
+
+        // The 10th byte can only hold the highest bit of a 64-bit value.
+        if (i == max_leb128_size - 1 && byte > 1)
+        {
+            throw std::invalid_argument("Compact encoding header is too large");
+        }
+
+        value |= (byte & 0x7F) << (7 * i);
+
+        if ((byte & 0x80) == 0)
+        {
+            return value;
+        }
+    }
+
+    throw std::invalid_argument("Compact encoding header is too large");
+}
+}  // namespace
+
+auto BigInt::from_bytes(std::span<std::byte const> bytes, std::endian endian, Signedness signedness) -> BigInt
+{
+    BigInt result;
+
+    if (bytes.empty())
+    {
+        return result;
+    }
+
+    constexpr size_t chunk_bytes = sizeof(ChunkType);
+    size_t const size = bytes.size();
+    size_t const full_chunks = size / chunk_bytes;
+    bool const little_endian = endian == std::endian::little;
+
+    // Get the byte at the given index counting from the least significant byte.
+    auto byte_at = [&bytes, size, little_endian](size_t index)
+    { return bytes[little_endian ? index : size - 1 - index]; };
+
+    result.chunks.assign((size + chunk_bytes - 1) / chunk_bytes, 0);
+
+    if (endian == std::endian::native)
+    {
+        // The chunks are stored in the same order as the bytes, copy them all at once.
+        if (little_endian)
+        {
+            std::memcpy(result.chunks.data(), bytes.data(), full_chunks * chunk_bytes);
+        }
+        else
+        {
+            for (size_t i = 0; i < full_chunks; ++i)
+            {
+                std::memcpy(&result.chunks[i], &bytes[size - ((i + 1) * chunk_bytes)], chunk_bytes);
+            }
+        }
+    }
+    else
+    {
+        // Copy every chunk and swap its bytes.
+        for (size_t i = 0; i < full_chunks; ++i)
+        {
+            size_t const offset = little_endian ? i * chunk_bytes : size - ((i + 1) * chunk_bytes);
+            std::memcpy(&result.chunks[i], &bytes[offset], chunk_bytes);
+            result.chunks[i] = std::byteswap(result.chunks[i]);
+        }
+    }
+
+    // Bytes of the partial most significant chunk.
+    for (size_t i = full_chunks * chunk_bytes; i < size; ++i)
+    {
+        result.chunks.back() |= std::to_integer<ChunkType>(byte_at(i)) << ((i % chunk_bytes) * 8);
+    }
+
+    bool const sign_set = (byte_at(size - 1) & sign_bit) != std::byte{0};
+    size_t const total_bits = size * 8;
+    size_t const top_bits = total_bits - ((result.chunks.size() - 1) * chunk_bits);
+
+    if (sign_set && signedness == Signedness::SignMagnitude)
+    {
+        result.negative = true;
+        result.chunks.back() &= ~(static_cast<ChunkType>(1) << (top_bits - 1));
+    }
+    else if (sign_set && signedness == Signedness::TwosComplement)
+    {
+        // The magnitude of a negative number is 2^total_bits - value, which is value with all bits inverted plus 1.
+        result.negative = true;
+        ChunkType carry = 1;
+
+        for (ChunkType &chunk : result.chunks)
+        {
+            chunk = ~chunk + carry;
+            carry = static_cast<ChunkType>(carry != 0 && chunk == 0);
+        }
+
+        if (top_bits < chunk_bits)
+        {
+            result.chunks.back() &= (static_cast<ChunkType>(1) << top_bits) - 1;
+        }
+    }
+
+    result.remove_leading_zeroes();
+
+    if (result.is_zero())
+    {
+        result.negative = false;
+    }
+
+    return result;
+}
+
+auto BigInt::byte_size(Signedness signedness) const noexcept -> size_t
+{
+    if (is_zero())
+    {
+        return 1;
+    }
+
+    size_t bits = bit_count();
+
+    // Signed representations need an extra bit for the sign, except for negative powers of two in two's complement,
+    // which are the smallest number representable in that many bits.
+    if (signedness == Signedness::SignMagnitude)
+    {
+        ++bits;
+    }
+    else if (signedness == Signedness::TwosComplement)
+    {
+        bool const power_of_two = std::has_single_bit(chunks.back())
+                                  && std::all_of(chunks.begin(), chunks.end() - 1, [](ChunkType c) { return c == 0; });
+        bits += (negative && power_of_two) ? 0 : 1;
+    }
+
+    return (bits + 7) / 8;
+}
+
+void BigInt::export_to(std::span<std::byte> bytes, std::endian endian, Signedness signedness) const
+{
+    bool const is_negative = negative && !is_zero();
+
+    if (is_negative && signedness == Signedness::Unsigned)
+    {
+        throw std::underflow_error("Negative number can't be exported as unsigned");
+    }
+    if (bytes.size() < byte_size(signedness))
+    {
+        throw std::overflow_error(std::format("Number doesn't fit in {} bytes", bytes.size()));
+    }
+
+    // The buffer can be smaller than the chunks if the most significant chunk has leading zero bytes.
+    size_t const magnitude_bytes = std::min(bytes.size(), chunks.size() * sizeof(ChunkType));
+
+    // Write the magnitude in little endian first.
+    write_magnitude(chunks, bytes.first(magnitude_bytes));
+
+    std::ranges::fill(bytes.subspan(magnitude_bytes), std::byte{0});
+
+    if (is_negative && signedness == Signedness::SignMagnitude)
+    {
+        bytes.back() |= sign_bit;
+    }
+    else if (is_negative && signedness == Signedness::TwosComplement)
+    {
+        // Negate the magnitude by inverting all bits and adding 1, which also sign-extends it to the whole buffer.
+        bool carry = true;
+
+        for (std::byte &byte : bytes)
+        {
+            byte = ~byte;
+
+            if (carry)
+            {
+                byte = static_cast<std::byte>(std::to_integer<unsigned>(byte) + 1);
+                carry = byte == std::byte{0};
+            }
+        }
+    }
+
+    if (endian == std::endian::big)
+    {
+        std::ranges::reverse(bytes);
+    }
+}
+
+auto BigInt::to_bytes(std::endian endian, Signedness signedness) const -> std::vector<std::byte>
+{
+    std::vector<std::byte> bytes(byte_size(signedness));
+    export_to(bytes, endian, signedness);
+    return bytes;
+}
+
+auto BigInt::compact_size() const noexcept -> size_t
+{
+    size_t const size = magnitude_size(chunks);
+    return leb128_size(static_cast<std::uint64_t>(size) << 1) + size;
+}
+
+void BigInt::encode_compact(std::span<BigInt const> values, std::vector<std::byte> &output)
+{
+    size_t position = output.size();
+    size_t total_size = 0;
+
+    for (BigInt const &value : values)
+    {
+        total_size += value.compact_size();
+    }
+
+    output.resize(position + total_size);
+
+    for (BigInt const &value : values)
+    {
+        size_t const size = magnitude_size(value.chunks);
+        bool const is_negative = value.negative && size != 0;
+
+        std::uint64_t const header = (static_cast<std::uint64_t>(size) << 1) | static_cast<std::uint64_t>(is_negative);
+
+        position += write_leb128(header, &output[position]);
+        write_magnitude(value.chunks, std::span(output).subspan(position, size));
+        position += size;
+    }
+}
+
+auto BigInt::decode_compact(std::span<std::byte const> bytes) -> std::vector<BigInt>
+{
+    std::vector<BigInt> result;
+    size_t position = 0;
+
+    while (position < bytes.size())
+    {
+        std::uint64_t const header = read_leb128(bytes, position);
+        std::uint64_t const size = header >> 1;
+
+        if (size > bytes.size() - position)
+        {
+            throw std::invalid_argument("Compact encoding is truncated");
+        }
+
+        BigInt value = from_bytes(bytes.subspan(position, static_cast<size_t>(size)));
+        value.negative = (header & 1) != 0 && !value.is_zero();
+        position += static_cast<size_t>(size);
+
+        result.push_back(std::move(value));
+    }
+
+    return result;
+}
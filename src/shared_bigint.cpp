@@ -0,0 +1,69 @@
+#include "bigint/shared_bigint.hpp"
+
+#include <ostream>
+
+using namespace BI;
+
+// The block is owned jointly by every SharedBigInt that points to it, through the reference count in the block, so no
+// single owner type can hold it. Only release() deletes it.
+// NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+SharedBigInt::SharedBigInt(BigInt num) : block{new Block(std::move(num))}
+{
+}
+
+SharedBigInt::SharedBigInt(BigIntView num) : SharedBigInt(BigInt(num))
+{
+}
+
+auto SharedBigInt::operator=(BigInt num) -> SharedBigInt &
+{
+    if (block != nullptr && block->references.load(std::memory_order_acquire) == 1)
+    {
+        block->value = std::move(num);
+    }
+    else
+    {
+        SharedBigInt(std::move(num)).swap(*this);
+    }
+
+    return *this;
+}
+
+auto SharedBigInt::get() const noexcept -> BigInt const &
+{
+    static BigInt const zero;
+    return block != nullptr ? block->value : zero;
+}
+
+auto SharedBigInt::mutate() -> BigInt &
+{
+    if (block == nullptr)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+        block = new Block(BigInt());
+    }
+    // Acquire the reads made through the references dropped by other threads before writing.
+    else if (block->references.load(std::memory_order_acquire) != 1)
+    {
+        SharedBigInt(block->value).swap(*this);
+    }
+
+    return block->value;
+}
+
+void SharedBigInt::release() noexcept
+{
+    // The last owner deletes the block after every other owner has finished with it.
+    if (block != nullptr && block->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+        delete block;
+    }
+
+    block = nullptr;
+}
+
+auto operator<<(std::ostream &os, SharedBigInt const &num) -> std::ostream &
+{
+    return os << num.get();
+}
@@ -1,96 +1,83 @@
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
+#include <charconv>
+#include <climits>
 #include <cmath>
 #include <format>
+#include <locale>
 #include <stdexcept>
 #include <utility>
 
 #include "bigint/bigint.hpp"
+#include "bigint/power_cache.hpp"
+#include "radix.hpp"
 
 using namespace BI;
 using namespace BI::detail;
 
-static auto const log2_10 = std::log2(10);
-
 // Character representation of all digits
-static constexpr std::array digits = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
+static constexpr std::array digits = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B',
+                                      'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N',
+                                      'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z'};
 
 // Character representation of all digits in lowercase.
-static constexpr std::array digits_lowercase = {
-    '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'
-};
+static constexpr std::array digits_lowercase = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b',
+                                                'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n',
+                                                'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z'};
+
+/// @brief Value of a digit character in any base up to 36, or a value larger than every base if it's not a digit.
+static constexpr auto digit_value(char c) -> unsigned
+{
+    if (c >= '0' && c <= '9')
+    {
+        return static_cast<unsigned>(c - '0');
+    }
+    if (c >= 'a' && c <= 'z')
+    {
+        return static_cast<unsigned>(c - 'a') + 10;
+    }
+    if (c >= 'A' && c <= 'Z')
+    {
+        return static_cast<unsigned>(c - 'A') + 10;
+    }
+
+    return std::numeric_limits<unsigned>::max();
+}
 
 static constexpr auto is_power_of_two(std::integral auto num) -> bool
 {
     return num != 0 && (num & (num - 1)) == 0;
 }
 
-auto BigInt::is_valid_digit(Base base, char c) -> bool
+void BI::detail::check_base(int base)
 {
-    switch (base)
+    if (base < min_base || base > max_base)
     {
-    case Base::Binary:
-        return c == '0' || c == '1';
-    case Base::Octal:
-        return c >= '0' && c <= '7';
-    case Base::Decimal:
-        return std::isdigit(c) != 0;
-    case Base::Hexadecimal:
-        return std::isxdigit(c) != 0;
+        throw std::invalid_argument(std::format("Base must be between {} and {}, got {}", min_base, max_base, base));
     }
 }
 
-auto BigInt::char_to_digit(Base base, char c) -> ChunkType
+auto BigInt::to_base(int base) -> Base
 {
-    if (!is_valid_digit(base, c))
-    {
-        throw std::invalid_argument(std::format("Invalid digit: {}", c));
-    }
-
-    switch (base)
-    {
-    case Base::Binary:
-    case Base::Octal:
-    case Base::Decimal:
-        return static_cast<ChunkType>(c - '0');
-    case Base::Hexadecimal:
-        return static_cast<ChunkType>(std::isdigit(c) != 0 ? (c - '0') : (std::tolower(c) - 'a' + 10));
-    }
+    check_base(base);
+    return static_cast<Base>(base);
 }
 
-auto BigInt::long_divide(std::string_view num, std::string &quotient, Base base, ChunkType divisor) -> ChunkType
+auto BigInt::is_valid_digit(Base base, char c) -> bool
 {
-    // Clear quotient string and reserve space.
-    quotient.clear();
-    quotient.reserve(num.size());
-
-    // Numeric value of base.
-    auto const base_num = std::to_underlying(base);
-    ChunkType dividend = 0;
+    return digit_value(c) < std::to_underlying(base);
+}
 
-    for (char digit : num)
+auto BigInt::char_to_digit(Base base, char c) -> ChunkType
+{
+    if (!is_valid_digit(base, c))
     {
-        dividend = dividend * base_num + char_to_digit(base, digit);
-
-        // If dividend >= divisor, divide and store the quotient
-        if (dividend >= divisor)
-        {
-            ChunkType quot = dividend / divisor;
-            ChunkType rem = dividend % divisor;
-
-            assert(base_num < digits.size() && quot < base_num);  // Should always be true for valid bases.
-            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
-            quotient += digits[quot];
-            dividend = rem;
-        }
-        else if (!quotient.empty())
-        {
-            // If dividend is less than divisor and quotient is non-empty, add '0'.
-            quotient += '0';
-        }
+        throw std::invalid_argument(std::format("Invalid digit: {}", c));
     }
 
-    return dividend;  // Return the remainder (which is the dividend now).
+    return digit_value(c);
 }
 
 void BigInt::power_of_two_base_to_binary(std::string_view num, Base base)
@@ -123,7 +110,7 @@ void BigInt::power_of_two_base_to_binary(std::string_view num, Base base)
         ChunkType const digit = char_to_digit(base, num[i]);
 
         // Digit without the bits that won't fit in the current chunk.
-        ChunkType const digit_masked = digit & ((1 << added_bits) - 1);
+        ChunkType const digit_masked = digit & ((static_cast<ChunkType>(1) << added_bits) - 1);
 
         // Add the bits corresponding to the digit to the current chunk.
         current_chunk = (digit_masked << current_chunk_bits) | current_chunk;
@@ -149,59 +136,116 @@ void BigInt::power_of_two_base_to_binary(std::string_view num, Base base)
     }
 }
 
-void BigInt::decimal_base_to_binary(std::string_view num)
+void BigInt::multiply_add(ChunkType multiplier, ChunkType addend)
 {
-    // Clear the chunks vector and reserve space.
-    chunks.clear();
-    chunks.reserve(static_cast<size_t>(static_cast<long double>(num.size()) * log2_10 / chunk_bits) + 1);
-
-    // Maximum number that can fit in a half-sized chunk.
-    static constexpr auto const half_chunk_bits = chunk_bits / 2;
-
-    // The process:
-    // 1. Long divide the number by 2 ^ half_chunk_bits, the remainder will span half of the chunk. Only half of the
-    //    chunk is processed at a time to avoid overflow.
-    // 2. Every two iterations, push the full chunk to the chunks vector.
-    // 3. Repeat until the number is 0.
-    bool is_half_chunk = false;
-    ChunkType current_chunk{0};
-    static auto divisor = static_cast<ChunkType>(1) << half_chunk_bits;
-    std::string current_num{num};
-    std::string new_num;
-
-    while (!current_num.empty())
-    {
-        // If the previous iteration was the first half of the chunk, the current iteration will be the second half,
-        // and vice versa.
-        is_half_chunk = !is_half_chunk;
-
-        // Long divide the current number by the divisor and store the remainder.
-        // The resulting quotient is stored in the new_num string.
-        ChunkType remainder = long_divide(current_num, new_num, Base::Decimal, divisor);
-
-        // Store the remainder in the current chunk.
-        if (is_half_chunk)
-        {
-            // First half of the chunk, just store the remainder.
-            current_chunk = remainder;
-        }
-        else
+    ChunkType carry = addend;
+
+    for (ChunkType &chunk : chunks)
+    {
+        auto const [low, high] = multiply_chunks(chunk, multiplier);
+        chunk = low + carry;
+        carry = high + static_cast<ChunkType>(chunk < low);
+    }
+
+    if (carry != 0 || chunks.empty())
+    {
+        chunks.push_back(carry);
+    }
+}
+
+auto BigInt::digits_per_chunk(Base base) noexcept -> size_t
+{
+    return radix_table<ChunkType>[std::to_underlying(base)].digits_per_chunk;
+}
+
+auto BigInt::big_base_powers(Base base, size_t count) -> std::vector<SharedBigInt>
+{
+    std::vector<SharedBigInt> powers;
+    powers.reserve(count);
+
+    // big_base^(2^i) is base^(digits_per_chunk * 2^i), each power is cached as the square of the previous one.
+    for (size_t i = 0; i < count; ++i)
+    {
+        powers.push_back(cached_power(std::to_underlying(base), digits_per_chunk(base) << i));
+    }
+
+    return powers;
+}
+
+void BigInt::big_base_to_binary(std::string_view num, Base base)
+{
+    auto const base_num = std::to_underlying(base);
+    auto const [digits_per_chunk, big_base] = radix_table<ChunkType>[base_num];
+
+    // Convert the digits with a multiply-add for every group of digits_per_chunk digits.
+    auto convert_small = [base, base_num, digits_per_chunk, big_base](std::string_view digits_str) -> BigInt
+    {
+        BigInt result;
+        result.chunks.clear();
+        result.chunks.reserve((digits_str.size() / digits_per_chunk) + 1);
+
+        // The first group takes the leftover digits so that every following group is full.
+        size_t group_size = digits_str.size() % digits_per_chunk;
+        group_size = group_size == 0 ? digits_per_chunk : group_size;
+
+        for (size_t i = 0; i < digits_str.size(); i += group_size, group_size = digits_per_chunk)
         {
-            // Full chunk, push it to the chunks vector and reset the chunk.
-            // The most significant half of the chunk is the remainder from this iteration.
-            chunks.push_back((remainder << half_chunk_bits) | current_chunk);
-            current_chunk = 0;
+            ChunkType group = 0;
+            ChunkType multiplier = 1;
+
+            for (char const c : digits_str.substr(i, group_size))
+            {
+                group = (group * base_num) + char_to_digit(base, c);
+                multiplier *= base_num;
+            }
+
+            result.multiply_add(group_size == digits_per_chunk ? big_base : multiplier, group);
         }
 
-        // Swap the current and new num strings to avoid reallocations.
-        std::swap(current_num, new_num);
+        result.remove_leading_zeroes();
+        return result;
+    };
+
+    size_t const threshold_digits = conversion_threshold * digits_per_chunk;
+
+    if (num.size() <= threshold_digits)
+    {
+        chunks = std::move(convert_small(num).chunks);
+        return;
     }
 
-    // If the last chunk is not full, push it to the chunks vector.
-    if (is_half_chunk)
+    // powers[i] is big_base^(2^i), which spans digits_per_chunk * 2^i digits.
+    size_t power_count = 0;
+    while ((digits_per_chunk << (power_count + 1)) < num.size())
     {
-        chunks.push_back(current_chunk);
+        ++power_count;
     }
+
+    std::vector<SharedBigInt> const powers = big_base_powers(base, power_count + 1);
+
+    // Split the digits so that the lower half spans the largest power that fits, then combine both halves with a
+    // single multiplication by that power.
+    auto convert = [&](auto &self, std::string_view digits_str) -> BigInt
+    {
+        if (digits_str.size() <= threshold_digits)
+        {
+            return convert_small(digits_str);
+        }
+
+        size_t level = 0;
+        while (level + 1 < powers.size() && (digits_per_chunk << (level + 1)) < digits_str.size())
+        {
+            ++level;
+        }
+
+        size_t const low_size = digits_per_chunk << level;
+        BigInt const high = self(self, digits_str.substr(0, digits_str.size() - low_size));
+        BigInt const low = self(self, digits_str.substr(digits_str.size() - low_size));
+
+        return (high * powers[level].get()) + low;
+    };
+
+    chunks = std::move(convert(convert, num).chunks);
 }
 
 void BigInt::base_to_binary(std::string_view num, Base base)
@@ -212,107 +256,446 @@ void BigInt::base_to_binary(std::string_view num, Base base)
     }
     else
     {
-        assert(base == Base::Decimal);
-        decimal_base_to_binary(num);
+        big_base_to_binary(num, base);
     }
 }
 
-auto BigInt::format_to_power_of_two_base(Base base, bool add_prefix, bool capitalize) const noexcept -> std::string
+namespace
 {
-    // Amount of bits that fit in a single digit of the specified base.
-    auto const digit_bits = static_cast<size_t>(std::countr_zero(std::to_underlying(base)));
-    size_t bit_count = this->bit_count();
-    std::string result;
-    // Reserve enough space for the result.
-    result.reserve((bit_count / digit_bits) + 1 + (add_prefix ? 2 : 0));
-
-    // Iterate through chunks of digit_bits bits and convert them to the specified base.
-    size_t i = 0;
-    while (i < bit_count)
+/// @brief Collects characters and hands them to a digit sink in fixed-size blocks.
+template<typename Sink>
+class BlockWriter
+{
+public:
+    explicit BlockWriter(Sink const &output) : sink{output}
     {
-        // Number of bits to extract from the current chunk.
-        size_t const extracted_bits = std::min(digit_bits, bit_count - i);
+    }
 
-        ChunkType digit = 0;
-        for (size_t j = 0; j < extracted_bits; ++j)
+    void put(char c)
+    {
+        if (size == buffer.size())
         {
-            digit |= static_cast<ChunkType>(get_bit_at(i + j)) << j;
+            flush();
         }
 
         // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
-        result += capitalize ? digits[digit] : digits_lowercase[digit];
+        buffer[size++] = c;
+    }
+
+    void put(std::string_view str)
+    {
+        for (char c : str)
+        {
+            put(c);
+        }
+    }
 
-        i += extracted_bits;
+    /// @brief Pass the buffered characters to the sink.
+    void flush()
+    {
+        if (size > 0)
+        {
+            sink(std::string_view(buffer.data(), size));
+            size = 0;
+        }
     }
 
-    // Reverse the result string to make it MSB first.
-    std::ranges::reverse(result);
+private:
+    Sink const &sink;
+    std::array<char, 4096> buffer{};
+    size_t size = 0;
+};
+}  // namespace
+
+auto BigInt::base_prefix(BigIntView num, Base base, bool capitalize) noexcept -> std::string_view
+{
+    switch (base)
+    {
+    case Base::Binary:
+        return capitalize ? "0B" : "0b";
+    case Base::Octal:
+        // Zero is already prefixed with a zero in octal.
+        return num.is_zero() ? "" : "0";
+    case Base::Hexadecimal:
+        return capitalize ? "0X" : "0x";
+    default:
+        // Other bases have no prefix.
+        return "";
+    }
+}
 
-    if (result.empty())
+auto BigInt::digit_count(BigIntView num, Base base) -> size_t
+{
+    if (num.is_zero())
     {
-        result = "0";
+        return 1;
     }
 
-    std::string prefix;
+    auto const magnitude = num.chunks();
+    auto const base_num = std::to_underlying(base);
+    size_t const bit_count =
+        ((magnitude.size() - 1) * chunk_bits) + static_cast<size_t>(std::bit_width(magnitude.back()));
 
-    if (add_prefix)
+    if (is_power_of_two(base_num))
     {
-        switch (base)
+        auto const digit_bits = static_cast<size_t>(std::countr_zero(base_num));
+        return (bit_count + digit_bits - 1) / digit_bits;
+    }
+
+    // 2^(bit_count - 1) <= |num| < 2^bit_count, so the number has either as many digits as 2^(bit_count - 1), or one
+    // more. Only compare against a power of the base when the bounds don't already decide it.
+    auto const log2_base = std::log2(static_cast<long double>(base_num));
+    auto const lower_log = static_cast<long double>(bit_count - 1) / log2_base;
+    auto const upper_log = static_cast<long double>(bit_count) / log2_base;
+    auto const lower_digits = static_cast<size_t>(lower_log) + 1;
+
+    if (static_cast<size_t>(upper_log) + 1 == lower_digits)
+    {
+        return lower_digits;
+    }
+
+    // The exponent depends on the size of this number, so the power is computed directly instead of filling the cache
+    // with a power that is rarely needed again and evicting the powers shared by every conversion.
+    BigInt const power = BigInt(base_num).pow(lower_digits);
+    return compare_magnitude(magnitude, power.chunks) == std::strong_ordering::less ? lower_digits : lower_digits + 1;
+}
+
+void BigInt::write_digits(BigIntView num, Base base, bool capitalize, DigitSink const &sink)
+{
+    auto const &digit_chars = capitalize ? digits : digits_lowercase;
+    auto const base_num = std::to_underlying(base);
+    auto const magnitude = num.chunks();
+    BlockWriter writer{sink};
+
+    if (num.is_zero())
+    {
+        writer.put('0');
+    }
+    else if (is_power_of_two(base_num))
+    {
+        // Amount of bits that fit in a single digit of the specified base.
+        auto const digit_bits = static_cast<size_t>(std::countr_zero(base_num));
+        ChunkType const digit_mask = (static_cast<ChunkType>(1) << digit_bits) - 1;
+
+        // Extract the digits starting from the most significant one, so the result doesn't have to be reversed.
+        for (size_t i = digit_count(num, base); i-- > 0;)
         {
-        case Base::Binary:
-            prefix = capitalize ? "0B" : "0b";
-            break;
-        case Base::Octal:
-            prefix = "0";
-            break;
-        case Base::Hexadecimal:
-            prefix = capitalize ? "0X" : "0x";
-            break;
-        case Base::Decimal:
-            assert(false);  // Should never happen.
+            size_t const chunk_index = (i * digit_bits) / chunk_bits;
+            size_t const bit_index = (i * digit_bits) % chunk_bits;
+            ChunkType digit = magnitude[chunk_index] >> bit_index;
+
+            // The digit may span two chunks.
+            if (bit_index + digit_bits > chunk_bits && chunk_index + 1 < magnitude.size())
+            {
+                digit |= magnitude[chunk_index + 1] << (chunk_bits - bit_index);
+            }
+
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+            writer.put(digit_chars[digit & digit_mask]);
+        }
+    }
+    else
+    {
+        // Split the number into "big digits", each holding as many digits as fit in a chunk. This only needs a single
+        // chunk division per chunk for every big digit instead of a full division for every digit.
+        auto const [digits_per_chunk, big_base] = radix_table<ChunkType>[base_num];
+        // Every big base is above 2^32, so a chunk never holds more than two big digits.
+        std::array<ChunkType, (2 * conversion_threshold) + 1> big_digits{};
+
+        // Write the digits of a number of at most conversion_threshold chunks, padded with zeroes to `width` digits if
+        // it's not 0. The chunks are divided in a copy on the stack, as the magnitude is only viewed.
+        auto write_small = [&](BigIntView value, size_t width)
+        {
+            assert(value.chunks().size() <= conversion_threshold);
+
+            std::array<ChunkType, conversion_threshold> quotient{};
+            std::ranges::copy(value.chunks(), quotient.begin());
+            size_t quotient_size = value.chunks().size();
+            size_t big_digit_count = 0;
+
+            while (quotient_size > 0)
+            {
+                big_digits[big_digit_count++] = divide_by_chunk(std::span(quotient).first(quotient_size), big_base);
+
+                while (quotient_size > 0 && quotient[quotient_size - 1] == 0)
+                {
+                    --quotient_size;
+                }
+            }
+
+            // Digits of every big digit, least significant first.
+            std::array<char, std::numeric_limits<ChunkType>::digits> buffer{};
+            size_t written = 0;
+
+            for (size_t i = big_digit_count; i-- > 0;)
+            {
+                size_t length = 0;
+                for (ChunkType big_digit = big_digits[i]; big_digit != 0; big_digit /= base_num)
+                {
+                    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+                    buffer[length++] = digit_chars[big_digit % base_num];
+                }
+
+                // Every big digit except the most significant one is padded with zeroes.
+                size_t const padded_length = i == big_digit_count - 1 ? length : digits_per_chunk;
+
+                if (written == 0 && width > 0)
+                {
+                    size_t const total = (i * digits_per_chunk) + padded_length;
+                    for (; written + total < width; ++written)
+                    {
+                        writer.put('0');
+                    }
+                }
+
+                for (size_t j = length; j < padded_length; ++j)
+                {
+                    writer.put('0');
+                }
+
+                for (size_t j = length; j-- > 0;)
+                {
+                    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+                    writer.put(buffer[j]);
+                }
+
+                written += padded_length;
+            }
+
+            // A zero value is written entirely as padding.
+            for (size_t j = written; j < width; ++j)
+            {
+                writer.put('0');
+            }
+        };
+
+        if (magnitude.size() <= conversion_threshold)
+        {
+            write_small(num, 0);
+        }
+        else
+        {
+            // powers[i] is big_base^(2^i), which spans digits_per_chunk * 2^i digits. The number is kept below the
+            // square of the largest power, so every split halves the number of digits and the leaves fit in a chunk.
+            auto const big_base_bits = static_cast<size_t>(std::bit_width(big_base)) - 1;
+            size_t power_count = 1;
+            while ((big_base_bits << power_count) < magnitude.size() * chunk_bits)
+            {
+                ++power_count;
+            }
+
+            std::vector<SharedBigInt> const powers = big_base_powers(base, power_count);
+
+            // Split the number at a power of the big base, and write the quotient and the remainder separately, most
+            // significant part first. Every part except the first one is padded to the exact number of digits it spans.
+            auto write_large = [&](auto &self, BigIntView value, size_t level, size_t width) -> void
+            {
+                if (width == 0)
+                {
+                    while (level > 0
+                           && compare_magnitude(powers[level - 1].get().chunks, value.chunks())
+                                  == std::strong_ordering::greater)
+                    {
+                        --level;
+                    }
+                }
+
+                if (level == 0 || value.chunks().size() <= conversion_threshold)
+                {
+                    write_small(value, width);
+                    return;
+                }
+
+                auto const [high, low] = div(value.abs(), powers[level - 1]);
+                size_t const low_width = digits_per_chunk << (level - 1);
+
+                self(self, high, level - 1, width == 0 ? 0 : width - low_width);
+                self(self, low, level - 1, low_width);
+            };
+
+            write_large(write_large, num, powers.size(), 0);
         }
     }
 
-    result.insert(0, prefix);
-    return result;
+    writer.flush();
 }
 
-auto BigInt::format_to_decimal() const -> std::string
+auto BigInt::format_to_base(BigIntView num, Base base, bool add_prefix, bool capitalize) -> std::string
 {
-    BigInt quotient{*this};
-    BigInt remainder;
-    static auto const ten = BigInt(10);
     std::string result;
-    // Reserve enough space for the result.
-    result.reserve(static_cast<size_t>(std::ceil(static_cast<long double>(quotient.bit_count()) / log2_10) + 1));
+    // Reserve enough space for the result, the digit count is estimated to avoid an exact count for decimal.
+    auto const bit_count = static_cast<long double>(num.chunks().size() * chunk_bits);
+    result.reserve(static_cast<size_t>(bit_count / std::log2(std::to_underlying(base))) + 4);
 
-    // Keep dividing modulo 10 and store the remainder in a string.
-    while (!quotient.is_zero())
+    if (num.is_negative())
     {
-        std::tie(quotient, remainder) = div(quotient, ten);
-        // Append the remainder to the result string.
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
-        result += digits[remainder.chunks[0]];
+        result += '-';
+    }
+    if (add_prefix)
+    {
+        result += base_prefix(num, base, capitalize);
     }
 
-    std::ranges::reverse(result);
-    return result.empty() ? "0" : result;
+    write_digits(num, base, capitalize, [&result](std::string_view block) { result += block; });
+    return result;
 }
 
-auto BigInt::format_to_base(Base base, bool add_prefix, bool capitalize) const -> std::string
+auto std::formatter<BI::BigIntView>::format(BI::BigIntView num, std::format_context &ctx) const
+    -> std::format_context::iterator
 {
-    if (is_zero())
+    auto out = ctx.out();
+    size_t field_width = width;
+
+    if (width_arg_id.has_value())
     {
-        return "0";
+        field_width = std::visit_format_arg(
+            [](auto const &value) -> size_t
+            {
+                using T = std::remove_cvref_t<decltype(value)>;
+
+                if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>)
+                {
+                    if (std::cmp_less(value, 0))
+                    {
+                        throw std::format_error("Width must not be negative");
+                    }
+                    return static_cast<size_t>(value);
+                }
+                else
+                {
+                    throw std::format_error("Width must be an integer");
+                }
+            },
+            ctx.arg(*width_arg_id)
+        );
     }
-    if (negative)
+
+    std::string_view const sign_str = num.is_negative()     ? "-"
+                                      : sign == Sign::Plus  ? "+"
+                                      : sign == Sign::Space ? " "
+                                                            : "";
+    std::string_view const prefix = add_prefix ? BigInt::base_prefix(num, base, capitalize) : "";
+
+    // Digit grouping from the locale, the string holds the size of each group starting from the least significant.
+    // The last group size repeats and a non-positive or CHAR_MAX size ends the grouping.
+    std::string grouping;
+    char separator = ',';
+
+    if (use_locale)
     {
-        return "-" + (-(*this)).format_to_base(base, add_prefix, capitalize);
+        std::locale const locale = ctx.locale();
+        auto const &punct = std::use_facet<std::numpunct<char>>(locale);
+        grouping = punct.grouping();
+        separator = punct.thousands_sep();
     }
-    if (is_power_of_two(std::to_underlying(base)))
+
+    auto valid_group = [](char group) { return group > 0 && group != CHAR_MAX; };
+
+    // Whether a separator goes before the digit that has `remaining` digits after it.
+    auto separator_before = [&grouping, &valid_group](size_t remaining) -> bool
+    {
+        size_t position = 0;
+
+        for (char const group : grouping)
+        {
+            if (!valid_group(group))
+            {
+                return false;
+            }
+
+            position += static_cast<size_t>(group);
+
+            if (position >= remaining)
+            {
+                return position == remaining;
+            }
+        }
+
+        return !grouping.empty() && (remaining - position) % static_cast<size_t>(grouping.back()) == 0;
+    };
+
+    // Number of separators needed for a number with `count` digits.
+    auto separator_count = [&grouping, &valid_group](size_t count) -> size_t
+    {
+        size_t position = 0;
+        size_t result = 0;
+
+        for (char const group : grouping)
+        {
+            if (!valid_group(group))
+            {
+                return result;
+            }
+
+            position += static_cast<size_t>(group);
+
+            if (position >= count)
+            {
+                return result;
+            }
+
+            ++result;
+        }
+
+        return grouping.empty() ? result : result + ((count - 1 - position) / static_cast<size_t>(grouping.back()));
+    };
+
+    bool const grouped = !grouping.empty() && valid_group(grouping.front());
+    size_t const digit_count = (field_width > 0 || grouped) ? BigInt::digit_count(num, base) : 0;
+    size_t const length = sign_str.size() + prefix.size() + digit_count + (grouped ? separator_count(digit_count) : 0);
+    size_t const padding = field_width > length ? field_width - length : 0;
+
+    auto put_fill = [this, &out](size_t count)
     {
-        return format_to_power_of_two_base(base, add_prefix, capitalize);
+        for (size_t i = 0; i < count; ++i)
+        {
+            out = std::ranges::copy_n(fill.begin(), static_cast<std::ptrdiff_t>(fill_size), out).out;
+        }
+    };
+
+    // Zero padding goes between the sign or prefix and the digits, and is ignored if an alignment is given.
+    bool const pad_zeroes = zero_pad && align == Align::Default;
+    size_t const left_padding = pad_zeroes              ? 0
+                                : align == Align::Left   ? 0
+                                : align == Align::Center ? padding / 2
+                                                         : padding;
+
+    put_fill(left_padding);
+    out = std::ranges::copy(sign_str, out).out;
+    out = std::ranges::copy(prefix, out).out;
+
+    if (pad_zeroes)
+    {
+        out = std::ranges::fill_n(out, static_cast<std::ptrdiff_t>(padding), '0');
     }
-    assert(base == Base::Decimal);
-    return format_to_decimal();
+
+    size_t written = 0;
+
+    BigInt::write_digits(
+        num,
+        base,
+        capitalize,
+        [&](std::string_view block)
+        {
+            if (!grouped)
+            {
+                out = std::ranges::copy(block, out).out;
+                return;
+            }
+
+            for (char const digit : block)
+            {
+                if (written > 0 && separator_before(digit_count - written))
+                {
+                    *out++ = separator;
+                }
+
+                *out++ = digit;
+                ++written;
+            }
+        }
+    );
+
+    put_fill(pad_zeroes ? 0 : padding - left_padding);
+    return out;
 }
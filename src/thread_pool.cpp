@@ -0,0 +1,220 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+
+using namespace BI::detail;
+
+namespace
+{
+/// @brief Pool and queue index of a worker thread.
+struct Worker
+{
+    ThreadPool const *pool{nullptr};
+    size_t queue{0};
+};
+
+/// @brief Get the pool and queue index of the current thread, the pool is null if it's not a worker.
+auto current_worker() noexcept -> Worker &
+{
+    thread_local Worker worker;
+    return worker;
+}
+}  // namespace
+
+ThreadPool::ThreadPool(size_t worker_count)
+{
+    queues.reserve(worker_count + 1);
+
+    for (size_t i = 0; i <= worker_count; ++i)
+    {
+        queues.push_back(std::make_unique<Queue>());
+    }
+
+    workers.reserve(worker_count);
+
+    for (size_t i = 0; i < worker_count; ++i)
+    {
+        workers.emplace_back([this, i](std::stop_token const &stop) { work(stop, i); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    for (auto &worker : workers)
+    {
+        worker.request_stop();
+    }
+
+    // The workers wait on wake with their stop token, so the stop requests wake them up.
+    workers.clear();
+}
+
+auto ThreadPool::get(size_t threads) -> ThreadPool &
+{
+    static std::mutex mutex;
+    // Pools in increasing size. A smaller pool may still be running tasks when a larger one is added, so it's kept.
+    static std::vector<std::unique_ptr<ThreadPool>> pools;
+
+    threads = resolve_threads(threads);
+
+    std::lock_guard const lock(mutex);
+
+    if (pools.empty() || pools.back()->thread_count() < threads)
+    {
+        pools.push_back(std::make_unique<ThreadPool>(std::max(threads, resolve_threads(0)) - 1));
+    }
+
+    return *pools.back();
+}
+
+auto ThreadPool::resolve_threads(size_t threads) noexcept -> size_t
+{
+    return threads == 0 ? std::max<size_t>(std::thread::hardware_concurrency(), 1) : threads;
+}
+
+void ThreadPool::run(std::span<std::function<void()> const> functions, size_t threads)
+{
+    if (functions.empty())
+    {
+        return;
+    }
+
+    std::vector<Task> tasks(functions.size());
+    size_t const queue = own_queue();
+    // The caller is one of the threads, the others are the first workers.
+    size_t const worker_limit = threads == 0 ? outside_queue() : std::min(threads - 1, outside_queue());
+
+    // Queue the tasks in reverse, so the owner takes the second one first and thieves take the last one first.
+    for (size_t i = functions.size(); i-- > 1;)
+    {
+        tasks[i].function = &functions[i];
+        tasks[i].worker_limit = worker_limit;
+        push(queue, &tasks[i]);
+    }
+
+    tasks[0].function = &functions[0];
+    execute(&tasks[0]);
+
+    for (size_t i = 1; i < tasks.size(); ++i)
+    {
+        while (!tasks[i].done.load(std::memory_order_acquire))
+        {
+            if (Task *const other = pop(queue))
+            {
+                execute(other);
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    for (Task const &task : tasks)
+    {
+        if (task.error)
+        {
+            std::rethrow_exception(task.error);
+        }
+    }
+}
+
+auto ThreadPool::own_queue() const noexcept -> size_t
+{
+    Worker const &worker = current_worker();
+    return worker.pool == this ? worker.queue : outside_queue();
+}
+
+void ThreadPool::push(size_t queue, Task *task)
+{
+    {
+        std::lock_guard const lock(queues[queue]->mutex);
+        queues[queue]->tasks.push_back(task);
+    }
+    {
+        std::lock_guard const lock(sleep_mutex);
+        ++push_count;
+    }
+
+    // A woken worker that may not run the task goes back to sleep, so wake all of them if some may not.
+    if (task->worker_limit < outside_queue())
+    {
+        wake.notify_all();
+    }
+    else
+    {
+        wake.notify_one();
+    }
+}
+
+auto ThreadPool::pop(size_t queue) -> Task *
+{
+    {
+        Queue &own = *queues[queue];
+        std::lock_guard const lock(own.mutex);
+
+        if (!own.tasks.empty())
+        {
+            Task *const task = own.tasks.back();
+            own.tasks.pop_back();
+            return task;
+        }
+    }
+
+    for (size_t offset = 1; offset < queues.size(); ++offset)
+    {
+        Queue &other = *queues[(queue + offset) % queues.size()];
+        std::lock_guard const lock(other.mutex);
+
+        // Threads outside the pool only run tasks while waiting for their own, so they may run any task.
+        bool const outside = queue == outside_queue();
+        auto const task = std::ranges::find_if(
+            other.tasks, [&](Task const *candidate) { return outside || queue < candidate->worker_limit; }
+        );
+
+        if (task != other.tasks.end())
+        {
+            Task *const result = *task;
+            other.tasks.erase(task);
+            return result;
+        }
+    }
+
+    return nullptr;
+}
+
+void ThreadPool::execute(Task *task) noexcept
+{
+    try
+    {
+        (*task->function)();
+    }
+    catch (...)
+    {
+        task->error = std::current_exception();
+    }
+
+    task->done.store(true, std::memory_order_release);
+}
+
+void ThreadPool::work(std::stop_token const &stop, size_t queue)
+{
+    current_worker() = Worker{.pool = this, .queue = queue};
+
+    while (!stop.stop_requested())
+    {
+        std::unique_lock lock(sleep_mutex);
+        size_t const seen = push_count;
+        lock.unlock();
+
+        if (Task *const task = pop(queue))
+        {
+            execute(task);
+            continue;
+        }
+
+        // Every task pushed before reading the count was seen by pop(), so only wait for newer ones.
+        lock.lock();
+        wake.wait(lock, stop, [this, seen] { return push_count != seen; });
+    }
+}
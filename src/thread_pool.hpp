@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace BI::detail
+{
+/// @brief Work-stealing thread pool for fork-join parallelism.
+///
+/// Every worker owns a queue, runs its own tasks newest first and steals the oldest tasks of the other queues when
+/// its own is empty. Threads outside the pool push to a shared queue. A thread that waits for its tasks runs queued
+/// tasks in the meantime, so nested parallel calls never block the pool. Every call limits the number of threads that
+/// run its tasks, so a single pool serves every thread count up to its size.
+class ThreadPool
+{
+public:
+    /// @brief Start a pool.
+    ///
+    /// @param worker_count Number of worker threads, the thread that calls run() also runs tasks.
+    explicit ThreadPool(size_t worker_count);
+
+    ThreadPool(ThreadPool const &) = delete;
+    ThreadPool(ThreadPool &&) = delete;
+    auto operator=(ThreadPool const &) -> ThreadPool & = delete;
+    auto operator=(ThreadPool &&) -> ThreadPool & = delete;
+
+    /// @brief Stop the workers once the queued tasks are done.
+    ~ThreadPool();
+
+    /// @brief Get a shared pool that can run tasks on the given number of threads, including the caller.
+    ///
+    /// Pools have at least one thread per hardware thread and are only added for larger thread counts, so usually a
+    /// single pool exists. Pools live until the program exits.
+    ///
+    /// @param threads Number of threads, 0 for one per hardware thread.
+    [[nodiscard]] static auto get(size_t threads) -> ThreadPool &;
+
+    /// @brief Get the number of threads an execution policy asks for, resolving 0 to one per hardware thread.
+    [[nodiscard]] static auto resolve_threads(size_t threads) noexcept -> size_t;
+
+    /// @brief Get the number of threads that run tasks, including the caller of run().
+    [[nodiscard]] auto thread_count() const noexcept -> size_t
+    {
+        return workers.size() + 1;
+    }
+
+    /// @brief Run functions in parallel and wait for all of them.
+    ///
+    /// The calling thread runs the first function itself. If functions throw, the first exception is rethrown once
+    /// all of them are done.
+    ///
+    /// @param functions The functions to run.
+    /// @param threads Maximum number of threads that run the functions, including the caller, 0 for all of them.
+    void run(std::span<std::function<void()> const> functions, size_t threads);
+
+    /// @brief Run functions in parallel on at most `threads` threads and wait for all of them, see run().
+    template<typename... Functions>
+    void invoke(size_t threads, Functions &&...functions)
+    {
+        std::array<std::function<void()>, sizeof...(Functions)> const tasks{
+            std::function<void()>(std::forward<Functions>(functions))...
+        };
+        run(tasks, threads);
+    }
+
+private:
+    struct Task
+    {
+        std::function<void()> const *function{};
+        /// @brief Workers whose queue index is below this may steal the task.
+        size_t worker_limit{};
+        std::atomic<bool> done{false};
+        std::exception_ptr error;
+    };
+
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task *> tasks;
+    };
+
+    /// @brief One queue per worker, followed by the queue of the threads outside the pool.
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::jthread> workers;
+
+    std::mutex sleep_mutex;
+    std::condition_variable_any wake;
+    /// @brief Number of tasks pushed so far, guarded by sleep_mutex. Idle workers wait for it to change, as the queued
+    ///        tasks may all be reserved for other workers.
+    size_t push_count{0};
+
+    /// @brief Get the index of the queue of the threads outside the pool, which is also the number of workers.
+    ///
+    /// Workers use this instead of workers.size(), as the workers start while the list of workers is still filled.
+    [[nodiscard]] auto outside_queue() const noexcept -> size_t
+    {
+        return queues.size() - 1;
+    }
+
+    /// @brief Get the index of the queue of the calling thread.
+    [[nodiscard]] auto own_queue() const noexcept -> size_t;
+
+    void push(size_t queue, Task *task);
+
+    /// @brief Take the newest task of a queue, or steal the oldest task of another one that the queue's thread may run.
+    [[nodiscard]] auto pop(size_t queue) -> Task *;
+
+    static void execute(Task *task) noexcept;
+
+    void work(std::stop_token const &stop, size_t queue);
+};
+}  // namespace BI::detail
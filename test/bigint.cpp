@@ -1,10 +1,95 @@
+#include "bigint/accumulator.hpp"
+#include "bigint/archive.hpp"
+#include "bigint/async.hpp"
+#include "bigint/batch.hpp"
 #include "bigint/bigint.hpp"
+#include "bigint/fixed_int.hpp"
+#include "bigint/lazy.hpp"
+#include "bigint/modular.hpp"
+#include "bigint/power_cache.hpp"
+#include "bigint/shared_bigint.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
 #include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <locale>
+#include <span>
+#include <sstream>
 #include <stdexcept>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
 
 using namespace BI;
 
+namespace
+{
+/// @brief Run a check on several threads at once and count its failures.
+///
+/// Catch can't report from other threads, so the check returns whether it passed and the caller checks the count
+/// once the threads are joined.
+///
+/// @param thread_count Number of threads.
+/// @param iterations Number of times every thread runs the check.
+/// @param check Called with the index of the thread and of the iteration, returns false if the check failed.
+/// @return The number of failed checks.
+auto count_thread_failures(
+    size_t thread_count,
+    size_t iterations,
+    std::function<bool(size_t, size_t)> const &check
+) -> size_t
+{
+    std::atomic<size_t> failures{0};
+
+    {
+        std::vector<std::jthread> threads;
+
+        for (size_t thread = 0; thread < thread_count; ++thread)
+        {
+            threads.emplace_back(
+                [&, thread]
+                {
+                    for (size_t iteration = 0; iteration < iterations; ++iteration)
+                    {
+                        if (!check(thread, iteration))
+                        {
+                            failures.fetch_add(1, std::memory_order_relaxed);
+                        }
+                    }
+                }
+            );
+        }
+    }
+
+    return failures.load();
+}
+
+/// @brief Get a number made of pseudo-random chunks.
+///
+/// @param seed State of a 64-bit linear congruential generator, advanced by one step per chunk.
+/// @param chunks Number of chunks.
+auto random_number(std::uint64_t &seed, size_t chunks) -> BigInt
+{
+    BigInt result;
+
+    for (size_t i = 0; i < chunks; ++i)
+    {
+        seed = (seed * 6364136223846793005ULL) + 1442695040888963407ULL;
+        result = (result << 64) + BigInt(seed);
+    }
+
+    return result;
+}
+}  // namespace
+
 TEST_CASE("BigInt default constructor")
 {
     BigInt const a;
@@ -144,6 +229,28 @@ TEST_CASE("BigInt Literals")
         REQUIRE(-0b1010101_bi == -0b1010101);
         REQUIRE(-0x7fffffffffffffff_bi == -0x7fffffffffffffffLL);
     }
+
+    SECTION("Digit separators")
+    {
+        REQUIRE(1'234'567'890_bi == 1234567890);
+        REQUIRE(0xFFFF'FFFF_bi == 0xFFFFFFFF);
+        REQUIRE(0b1010'1010_bi == 0b10101010);
+    }
+
+    SECTION("Large numbers")
+    {
+        REQUIRE(340282366920938463463374607431768211456_bi == BigInt("340282366920938463463374607431768211456"));
+        REQUIRE(0x1'0000000000000000'0000000000000000_bi == 1_bi << 128);
+        REQUIRE(0777777777777777777777777_bi == (1_bi << 72) - 1_bi);
+    }
+
+    SECTION("Compile time")
+    {
+        // The chunks are computed at compile time, with leading zeroes.
+        constexpr auto chunks = BI::detail::literal_chunks<'0', 'x', '1', '0'>();
+        static_assert(chunks[0] == 16);
+        static_assert(std::ranges::all_of(std::span(chunks).subspan(1), [](auto chunk) { return chunk == 0; }));
+    }
 }
 
 BigInt const a = 1234567890_bi;
@@ -235,6 +342,446 @@ TEST_CASE("BigInt to String conversion")
     }
 }
 
+TEST_CASE("BigInt Arbitrary base conversion")
+{
+    SECTION("Parsing")
+    {
+        REQUIRE(BigInt("zz", 36) == 1295);
+        REQUIRE(BigInt("-ZZ", 36) == -1295);
+        REQUIRE(BigInt("v0", 32) == 992);
+        REQUIRE(BigInt("-10012001001112202200", 3) == -a);
+        REQUIRE(BigInt("1234567890", 10) == a);
+        REQUIRE(BigInt("i2q1k5ih081f242q90yahwb35e8zbpx", 36) == x);
+    }
+
+    SECTION("Formatting")
+    {
+        REQUIRE(a.to_string(36) == "kf12oi");
+        REQUIRE(a.to_string(36, true) == "KF12OI");
+        REQUIRE(a.to_string(32) == "14pc0mi");
+        REQUIRE((-a).to_string(3) == "-10012001001112202200");
+        REQUIRE(x.to_string(36) == "i2q1k5ih081f242q90yahwb35e8zbpx");
+        REQUIRE(z.to_string() == z_str);
+        REQUIRE((0_bi).to_string(36) == "0");
+    }
+
+    SECTION("Round trip")
+    {
+        BigInt const large = z.pow(20);
+
+        for (int base = 2; base <= 36; ++base)
+        {
+            REQUIRE(BigInt(z.to_string(base), base) == z);
+            REQUIRE(BigInt(z_neg.to_string(base), base) == z_neg);
+            REQUIRE(BigInt(large.to_string(base), base) == large);
+        }
+    }
+
+    SECTION("Invalid bases and digits")
+    {
+        REQUIRE_THROWS_AS(BigInt("1", 1), std::invalid_argument);
+        REQUIRE_THROWS_AS(BigInt("1", 37), std::invalid_argument);
+        REQUIRE_THROWS_AS(BigInt("2", 2), std::invalid_argument);
+        REQUIRE_THROWS_AS(BigInt("z", 35), std::invalid_argument);
+        REQUIRE_THROWS_AS(BigInt("", 10), std::invalid_argument);
+        REQUIRE_THROWS_AS(BigInt("-", 10), std::invalid_argument);
+        REQUIRE_THROWS_AS(a.to_string(37), std::invalid_argument);
+    }
+}
+
+TEST_CASE("BigInt Stream input")
+{
+    SECTION("operator>>")
+    {
+        std::istringstream stream("  1234567890 -987654321 ff");
+        BigInt c;
+        BigInt d;
+        BigInt e;
+        stream >> c >> d >> std::hex >> e;
+        REQUIRE(c == a);
+        REQUIRE(d == b_neg);
+        REQUIRE(e == 255);
+        REQUIRE(stream.eof());
+    }
+
+    SECTION("Stops at the first invalid digit")
+    {
+        std::istringstream stream("123abc");
+        REQUIRE(BigInt::read(stream) == 123);
+        REQUIRE(stream.peek() == 'a');
+    }
+
+    SECTION("Invalid input")
+    {
+        std::istringstream stream("abc");
+        BigInt c = a;
+        stream >> c;
+        REQUIRE(stream.fail());
+        REQUIRE(c == a);
+
+        std::istringstream sign_only("-");
+        REQUIRE_THROWS_AS(BigInt::read(sign_only), std::invalid_argument);
+    }
+
+    SECTION("Large numbers in every base")
+    {
+        BigInt const large = z.pow(20);
+
+        for (int base = 2; base <= 36; ++base)
+        {
+            std::istringstream stream(large.to_string(base) + " " + z_neg.to_string(base));
+            REQUIRE(BigInt::read(stream, base) == large);
+            REQUIRE(BigInt::read(stream, base) == z_neg);
+        }
+    }
+}
+
+TEST_CASE("BigInt File input")
+{
+    auto const path = std::filesystem::temp_directory_path() / "bigint_file_input_test.txt";
+    BigInt const large = z.pow(20);
+
+    SECTION("Decimal")
+    {
+        std::ofstream(path) << "\n " << std::string(large) << "\n";
+        REQUIRE(BigInt::from_file(path) == large);
+    }
+
+    SECTION("Hexadecimal")
+    {
+        std::ofstream(path) << z_neg.to_string(16);
+        REQUIRE(BigInt::from_file(path, 16) == z_neg);
+    }
+
+    SECTION("Invalid contents")
+    {
+        std::ofstream(path) << "12 34";
+        REQUIRE_THROWS_AS(BigInt::from_file(path), std::invalid_argument);
+    }
+
+    std::filesystem::remove(path);
+
+    SECTION("Missing file")
+    {
+        REQUIRE_THROWS_AS(BigInt::from_file(path), std::system_error);
+    }
+}
+
+TEST_CASE("BigInt Stream output")
+{
+    SECTION("operator<<")
+    {
+        std::ostringstream stream;
+        stream << a << ' ' << z_neg << ' ' << std::hex << 255_bi << ' ' << std::uppercase << std::showbase << 255_bi;
+        REQUIRE(stream.str() == a_str + " -" + z_str + " ff 0XFF");
+    }
+
+    SECTION("Width and fill")
+    {
+        std::ostringstream stream;
+        stream << std::setw(12) << a << '|' << std::left << std::setfill('*') << std::setw(12) << b_neg << '|'
+               << std::internal << std::setw(6) << std::showpos << 42_bi << '|' << a;
+        REQUIRE(stream.str() == "  1234567890|-987654321**|+***42|+1234567890");
+    }
+
+    SECTION("Large numbers in any base")
+    {
+        BigInt const large = z.pow(20);
+
+        for (int base : {2, 10, 16, 36})
+        {
+            std::ostringstream stream;
+            large.write(stream, base);
+            REQUIRE(stream.str() == large.to_string(base));
+        }
+    }
+}
+
+TEST_CASE("BigInt File output")
+{
+    auto const path = std::filesystem::temp_directory_path() / "bigint_file_output_test.txt";
+    BigInt const large = -z.pow(20);
+
+    large.to_file(path);
+    REQUIRE(BigInt::from_file(path) == large);
+
+    large.to_file(path, 36, true);
+    REQUIRE(BigInt::from_file(path, 36) == large);
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("BigInt Binary serialization")
+{
+    auto bytes_of = [](std::initializer_list<unsigned> values)
+    {
+        std::vector<std::byte> bytes;
+
+        for (unsigned const value : values)
+        {
+            bytes.push_back(static_cast<std::byte>(value));
+        }
+
+        return bytes;
+    };
+
+    SECTION("Byte size")
+    {
+        REQUIRE(BigInt().byte_size() == 1);
+        REQUIRE((255_bi).byte_size() == 1);
+        REQUIRE((256_bi).byte_size() == 2);
+        REQUIRE((127_bi).byte_size(Signedness::SignMagnitude) == 1);
+        REQUIRE((128_bi).byte_size(Signedness::SignMagnitude) == 2);
+        REQUIRE((127_bi).byte_size(Signedness::TwosComplement) == 1);
+        REQUIRE((128_bi).byte_size(Signedness::TwosComplement) == 2);
+        REQUIRE((-128_bi).byte_size(Signedness::TwosComplement) == 1);
+        REQUIRE((-129_bi).byte_size(Signedness::TwosComplement) == 2);
+        REQUIRE((-(1_bi << 64)).byte_size(Signedness::TwosComplement) == 9);
+        REQUIRE(((1_bi << 64) - 1_bi).byte_size(Signedness::TwosComplement) == 9);
+    }
+
+    SECTION("Known byte values")
+    {
+        REQUIRE((0x1234_bi).to_bytes() == bytes_of({0x34, 0x12}));
+        REQUIRE((0x1234_bi).to_bytes(std::endian::big) == bytes_of({0x12, 0x34}));
+        REQUIRE((-128_bi).to_bytes(std::endian::big, Signedness::TwosComplement) == bytes_of({0x80}));
+        REQUIRE((-129_bi).to_bytes(std::endian::big, Signedness::TwosComplement) == bytes_of({0xFF, 0x7F}));
+        REQUIRE((-129_bi).to_bytes(std::endian::big, Signedness::SignMagnitude) == bytes_of({0x80, 0x81}));
+
+        REQUIRE(BigInt::from_bytes(bytes_of({0xFF, 0x7F}), std::endian::big, Signedness::TwosComplement) == -129_bi);
+        REQUIRE(BigInt::from_bytes(bytes_of({0x80, 0x81}), std::endian::big, Signedness::SignMagnitude) == -129_bi);
+        REQUIRE(BigInt::from_bytes(bytes_of({0xFF, 0xFF}), std::endian::little) == 0xFFFF_bi);
+        REQUIRE(BigInt::from_bytes(bytes_of({0xFF, 0xFF}), std::endian::little, Signedness::TwosComplement) == -1_bi);
+        REQUIRE(BigInt::from_bytes({}) == 0_bi);
+    }
+
+    SECTION("Round trip")
+    {
+        for (BigInt const &num : {a, x, y, z, -x, -y, -z, -1_bi, (1_bi << 128), -(1_bi << 128)})
+        {
+            for (std::endian const endian : {std::endian::little, std::endian::big})
+            {
+                for (Signedness const signedness : {Signedness::SignMagnitude, Signedness::TwosComplement})
+                {
+                    REQUIRE(BigInt::from_bytes(num.to_bytes(endian, signedness), endian, signedness) == num);
+                }
+
+                if (num >= 0_bi)
+                {
+                    REQUIRE(BigInt::from_bytes(num.to_bytes(endian), endian) == num);
+                }
+            }
+        }
+    }
+
+    SECTION("Export to a larger buffer")
+    {
+        std::vector<std::byte> buffer(32);
+
+        (-2_bi).export_to(buffer, std::endian::big, Signedness::TwosComplement);
+        REQUIRE(buffer.front() == std::byte{0xFF});
+        REQUIRE(buffer.back() == std::byte{0xFE});
+        REQUIRE(BigInt::from_bytes(buffer, std::endian::big, Signedness::TwosComplement) == -2_bi);
+
+        x.export_to(buffer);
+        REQUIRE(BigInt::from_bytes(buffer) == x);
+    }
+
+    SECTION("Errors")
+    {
+        std::vector<std::byte> buffer(1);
+
+        REQUIRE_THROWS_AS((256_bi).export_to(buffer), std::overflow_error);
+        REQUIRE_THROWS_AS(
+            (128_bi).export_to(buffer, std::endian::little, Signedness::TwosComplement), std::overflow_error
+        );
+        REQUIRE_THROWS_AS((-1_bi).to_bytes(), std::underflow_error);
+    }
+}
+
+TEST_CASE("BigInt Compact serialization")
+{
+    SECTION("Size")
+    {
+        REQUIRE(BigInt().compact_size() == 1);
+        REQUIRE((1_bi).compact_size() == 2);
+        REQUIRE((-255_bi).compact_size() == 2);
+        REQUIRE((256_bi).compact_size() == 3);
+        REQUIRE(((1_bi << 127)).compact_size() == 17);
+        REQUIRE(((1_bi << 504)).compact_size() == 66);
+    }
+
+    SECTION("Known encoding")
+    {
+        std::vector<std::byte> bytes;
+        BigInt::encode_compact(std::vector{0_bi, -0x1234_bi}, bytes);
+
+        REQUIRE(bytes == std::vector{std::byte{0x00}, std::byte{0x05}, std::byte{0x34}, std::byte{0x12}});
+    }
+
+    SECTION("Round trip")
+    {
+        std::vector<BigInt> const values{a, b_neg, BigInt(), -BigInt(), x, y_neg, z, z_neg.pow(9), 1_bi << 1000};
+        std::vector<std::byte> bytes{std::byte{0x00}};
+
+        // Encodings are appended after the existing contents.
+        BigInt::encode_compact(values, bytes);
+        bytes.erase(bytes.begin());
+
+        size_t expected_size = 0;
+        for (BigInt const &value : values)
+        {
+            expected_size += value.compact_size();
+        }
+        REQUIRE(bytes.size() == expected_size);
+
+        std::vector<BigInt> const decoded = BigInt::decode_compact(bytes);
+        REQUIRE(decoded == values);
+        REQUIRE(BigInt::decode_compact({}).empty());
+    }
+
+    SECTION("Invalid encoding")
+    {
+        std::vector<std::byte> bytes;
+        BigInt::encode_compact(std::vector{x}, bytes);
+        bytes.pop_back();
+
+        REQUIRE_THROWS_AS(BigInt::decode_compact(bytes), std::invalid_argument);
+        REQUIRE_THROWS_AS(BigInt::decode_compact(std::vector{std::byte{0x80}}), std::invalid_argument);
+        REQUIRE_THROWS_AS(BigInt::decode_compact(std::vector<std::byte>(11, std::byte{0xFF})), std::invalid_argument);
+    }
+}
+
+TEST_CASE("BigIntView")
+{
+    using ChunkType = BigInt::ChunkType;
+
+    SECTION("View of a BigInt")
+    {
+        BigIntView const view = x_neg;
+
+        REQUIRE(view.is_negative());
+        REQUIRE(view.abs() == x);
+        REQUIRE(BigInt(view) == x_neg);
+        REQUIRE(BigIntView(BigInt()).is_zero());
+        REQUIRE(BigIntView(-BigInt()) == BigIntView());
+    }
+
+    SECTION("View of an external buffer")
+    {
+        std::vector<ChunkType> const buffer{5, 0, 0};
+        BigIntView const view(buffer, true);
+
+        REQUIRE(view.chunks().size() == 1);
+        REQUIRE(view == -5_bi);
+        REQUIRE(BigIntView(std::span(buffer).subspan(1)).is_zero());
+        REQUIRE(!BigIntView(std::span(buffer).subspan(1), true).is_negative());
+    }
+
+    SECTION("Arithmetic")
+    {
+        for (BigInt const &lhs : {a, b, x, y, z, a_neg, x_neg, z_neg, BigInt()})
+        {
+            for (BigInt const &rhs : {a, b, x, y_neg, z_neg})
+            {
+                BigIntView const lhs_view = lhs;
+                BigIntView const rhs_view = rhs;
+
+                REQUIRE(lhs_view + rhs_view == lhs + rhs);
+                REQUIRE(lhs_view - rhs_view == lhs - rhs);
+                REQUIRE(lhs_view * rhs_view == lhs * rhs);
+                REQUIRE(lhs_view / rhs_view == lhs / rhs);
+                REQUIRE(lhs_view % rhs_view == lhs % rhs);
+                REQUIRE((lhs_view <=> rhs_view) == (lhs <=> rhs));
+            }
+        }
+
+        REQUIRE(x - BigIntView(x) == 0_bi);
+        REQUIRE(std::format("{}", x_neg + BigIntView(x)) == "0");
+        REQUIRE_THROWS_AS(BigIntView(x) / BigIntView(), std::domain_error);
+    }
+
+    SECTION("Formatting")
+    {
+        BigIntView const view = z_neg;
+
+        REQUIRE(std::format("{}", view) == "-" + z_str);
+        REQUIRE(std::format("{:>#10x}", BigIntView(a)) == std::format("{:>#10x}", a));
+        REQUIRE(view.to_string(36) == z_neg.to_string(36));
+
+        // A view of a buffer above the conversion threshold, with a leading zero chunk, formats like a copy of it.
+        std::vector<ChunkType> buffer(100, 0x0123456789ABCDEFULL);
+        buffer.back() = 0;
+        std::vector<ChunkType> const original = buffer;
+        BigIntView const large(buffer, true);
+        BigInt const large_copy(large);
+
+        REQUIRE(std::format("{}", large) == std::format("{}", large_copy));
+        REQUIRE(std::format("{:*^2500}", large) == std::format("{:*^2500}", large_copy));
+        REQUIRE(large.to_string(7) == large_copy.to_string(7));
+        REQUIRE(buffer == original);
+    }
+
+    SECTION("Hashing")
+    {
+        std::vector<ChunkType> const buffer(BigIntView(y).chunks().begin(), BigIntView(y).chunks().end());
+
+        REQUIRE(std::hash<BigIntView>{}(BigIntView(buffer)) == std::hash<BigInt>{}(y));
+        REQUIRE(std::hash<BigInt>{}(BigInt()) == std::hash<BigInt>{}(-BigInt()));
+        REQUIRE(std::hash<BigInt>{}(x) != std::hash<BigInt>{}(x_neg));
+    }
+}
+
+TEST_CASE("BigIntArchive")
+{
+    auto const path = std::filesystem::temp_directory_path() / "bigint_archive_test.bin";
+
+    SECTION("Round trip")
+    {
+        std::vector<BigInt> const values{a, x_neg, BigInt(), z, -BigInt(), y_neg.pow(7), b};
+        BigIntArchive::write(path, values);
+
+        BigIntArchive const archive(path);
+        REQUIRE(archive.size() == values.size());
+
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            REQUIRE(archive[i] == values[i]);
+            REQUIRE(archive.at(i) == values[i]);
+        }
+
+        REQUIRE_THROWS_AS(archive.at(values.size()), std::out_of_range);
+
+        // Views stay valid as long as a copy of the archive is alive.
+        BigIntView view;
+        {
+            BigIntArchive const copy = archive;
+            view = copy[5];
+        }
+        REQUIRE(view == y_neg.pow(7));
+    }
+
+    SECTION("Empty archive")
+    {
+        BigIntArchive::write(path, {});
+        BigIntArchive const archive(path);
+
+        REQUIRE(archive.empty());
+        REQUIRE_THROWS_AS(archive.at(0), std::out_of_range);
+    }
+
+    SECTION("Invalid archive")
+    {
+        std::ofstream(path) << "not an archive, just some text";
+        REQUIRE_THROWS_AS(BigIntArchive(path), std::invalid_argument);
+
+        std::filesystem::remove(path);
+        REQUIRE_THROWS_AS(BigIntArchive(path), std::system_error);
+    }
+
+    std::filesystem::remove(path);
+}
+
 TEST_CASE("BigInt Unary operators")
 {
     SECTION("Unary plus")
@@ -317,6 +864,7 @@ TEST_CASE("BigInt Comparison")
 
 TEST_CASE("BigInt Addition")
 {
+    REQUIRE(0xffffffffffffffffffffffffffffffff_bi + 1_bi == 0x100000000000000000000000000000000_bi);
     REQUIRE(x + y == 1398801053121203495828109880137080530615849470438_bi);
     REQUIRE(x + (-y) == 368046011657180833755187620605837985211634426436_bi);
     REQUIRE((-x) + y == -368046011657180833755187620605837985211634426436_bi);
@@ -325,6 +873,7 @@ TEST_CASE("BigInt Addition")
 
 TEST_CASE("BigInt Subtraction")
 {
+    REQUIRE(0x100000000000000000000000000000000_bi - 1_bi == 0xffffffffffffffffffffffffffffffff_bi);
     REQUIRE(x - y == 368046011657180833755187620605837985211634426436_bi);
     REQUIRE(x - (-y) == 1398801053121203495828109880137080530615849470438_bi);
     REQUIRE((-x) - y == -1398801053121203495828109880137080530615849470438_bi);
@@ -368,77 +917,1483 @@ TEST_CASE("BigInt Multiplication")
     );
 }
 
-TEST_CASE("BigInt Division and Modulo")
+TEST_CASE("BigInt Large multiplication")
 {
-    BigInt c = 106048574244834508800_bi;
-    BigInt d = -429391241160_bi;
+    // Seed of the pseudo-random operands, which are large enough for Karatsuba's algorithm.
+    std::uint64_t seed = 1;
 
-    SECTION("BigInt Division")
+    // Multiply by one 64-bit piece of rhs at a time, which never uses Karatsuba's algorithm.
+    auto reference_product = [](BigInt const &lhs, BigInt rhs)
     {
-        REQUIRE(x / y == 1_bi);
-        REQUIRE(x / (-y) == -1_bi);
-        REQUIRE((-x) / y == -1_bi);
-        REQUIRE((-x) / (-y) == 1_bi);
-        REQUIRE(c / d == -246974237_bi);
+        BigInt result;
+        BigInt const piece_base = 1_bi << 64;
 
-        SECTION("Division by zero")
+        for (size_t shift = 0; rhs != BigInt(); shift += 64, rhs >>= 64)
         {
-            REQUIRE_THROWS_AS(a / 0_bi, std::domain_error);
+            result += (lhs * (rhs % piece_base)) << shift;
         }
-    }
 
-    SECTION("BigInt Modulo")
-    {
-        REQUIRE(x % y == 368046011657180833755187620605837985211634426436_bi);
-        REQUIRE(x % (-y) == 368046011657180833755187620605837985211634426436_bi);
-        REQUIRE((-x) % y == -368046011657180833755187620605837985211634426436_bi);
-        REQUIRE((-x) % (-y) == -368046011657180833755187620605837985211634426436_bi);
-        REQUIRE(c % d == 84860513880_bi);
+        return result;
+    };
 
-        SECTION("Division by zero")
+    SECTION("Powers of two minus one")
+    {
+        for (size_t const n : {1000, 2047, 2048, 2049, 4100, 16384})
         {
-            REQUIRE_THROWS_AS(x % 0_bi, std::domain_error);
+            BigInt const a = (1_bi << n) - 1_bi;
+            REQUIRE(a * a == (1_bi << (2 * n)) - (1_bi << (n + 1)) + 1_bi);
+
+            for (size_t const k : {64, 700, 3000, 100000})
+            {
+                BigInt const b = (1_bi << k) - 1_bi;
+                REQUIRE(a * b == (1_bi << (n + k)) - (1_bi << n) - (1_bi << k) + 1_bi);
+            }
         }
     }
-}
 
-TEST_CASE("BigInt Power")
-{
-    SECTION("Zero power")
+    SECTION("Random chunks")
     {
-        REQUIRE(a.pow(0) == 1_bi);
-        REQUIRE((-a).pow(0) == 1_bi);
-    }
+        for (size_t const lhs_chunks : {32, 33, 50, 64, 65, 127, 300})
+        {
+            for (size_t const rhs_chunks : {31, 32, 45, 64, 100, 257})
+            {
+                BigInt const a = random_number(seed, lhs_chunks);
+                BigInt const b = random_number(seed, rhs_chunks);
+                BigInt const expected = reference_product(a, b);
 
-    SECTION("Power of one")
-    {
-        REQUIRE(a.pow(1) == 1234567890_bi);
-        REQUIRE((-a).pow(1) == -1234567890_bi);
+                REQUIRE(a * b == expected);
+                REQUIRE(b * a == expected);
+                REQUIRE((-a) * b == -expected);
+            }
+        }
     }
 
-    SECTION("Positive powers")
+    SECTION("Parallel execution")
     {
-        REQUIRE(a.pow(2) == 1524157875019052100_bi);
-        REQUIRE(a.pow(5) == 2867971860299718107233761438093672048294900000_bi);
-        REQUIRE(
-            a.pow(10) == 8225262591471025795047611436615355477641378922955141680937016996764162077997366010000000000_bi
-        );
+        ExecutionPolicy const parallel{.threads = 4, .parallel_threshold = 32};
+        REQUIRE(parallel.is_parallel(32));
+        REQUIRE_FALSE(parallel.is_parallel(31));
+        REQUIRE_FALSE(ExecutionPolicy::serial().is_parallel(100000));
+
+        for (size_t const chunks : {40, 100, 1000, 3000})
+        {
+            BigInt const a = random_number(seed, chunks);
+            BigInt const b = random_number(seed, chunks + (chunks / 3));
+            BigInt const expected = multiply(a, b, ExecutionPolicy::serial());
+
+            REQUIRE(multiply(a, b, parallel) == expected);
+            REQUIRE(multiply(-b, a, ExecutionPolicy::parallel()) == -expected);
+            REQUIRE(multiply(a, BigInt(), parallel) == BigInt());
+        }
     }
 
-    SECTION("Negative base positive powers")
+    SECTION("Default policy")
     {
-        REQUIRE((-a).pow(2) == 1524157875019052100_bi);
-        REQUIRE((-a).pow(5) == -2867971860299718107233761438093672048294900000_bi);
+        REQUIRE(get_default_execution_policy().threads == 1);
+
+        set_default_execution_policy(ExecutionPolicy{.threads = 3, .parallel_threshold = 64});
+        ExecutionPolicy const policy = get_default_execution_policy();
+        REQUIRE(policy.threads == 3);
+        REQUIRE(policy.parallel_threshold == 64);
+
+        BigInt const a = random_number(seed, 500);
+        BigInt const b = random_number(seed, 700);
+        BigInt const product = a * b;
+
+        set_default_execution_policy(ExecutionPolicy::serial());
+        REQUIRE(product == a * b);
+        REQUIRE(get_default_execution_policy().threads == 1);
     }
 
-    SECTION("Edge cases")
+    SECTION("Concurrent policies")
     {
-        REQUIRE((0_bi).pow(1000) == 0_bi);
-        REQUIRE((1_bi).pow(1000) == 1_bi);
+        BigInt const a = random_number(seed, 600);
+        BigInt const b = random_number(seed, 900);
+        BigInt const expected = multiply(a, b, ExecutionPolicy::serial());
+        size_t failures = 0;
+
+        {
+            // Every policy set here has a threshold of 50 chunks per thread, a torn read would break that.
+            std::jthread const writer(
+                [](std::stop_token const &stop)
+                {
+                    for (size_t i = 0; !stop.stop_requested(); ++i)
+                    {
+                        size_t const threads = 2 + (i % 5);
+                        set_default_execution_policy(
+                            ExecutionPolicy{.threads = threads, .parallel_threshold = 50 * threads}
+                        );
+                    }
+                }
+            );
+
+            // Every thread multiplies with its own thread count, the pool must serve all of them at once.
+            failures = count_thread_failures(
+                4,
+                20,
+                [&](size_t thread, size_t /*iteration*/)
+                {
+                    ExecutionPolicy const policy = get_default_execution_policy();
+                    ExecutionPolicy const own{.threads = thread + 1, .parallel_threshold = 32};
+                    return policy.parallel_threshold == 50 * policy.threads && multiply(a, b, own) == expected;
+                }
+            );
+        }
+
+        set_default_execution_policy(ExecutionPolicy::serial());
+        REQUIRE(failures == 0);
+    }
+}
+
+TEST_CASE("BigInt Reductions")
+{
+    std::vector<BigInt> values;
+
+    for (std::int64_t i = 1; i <= 2000; ++i)
+    {
+        // Mix small and large numbers of both signs.
+        BigInt value = (i % 7 == 0) ? (BigInt(i) << static_cast<size_t>(i)) + BigInt(i) : BigInt(i * 1000003);
+        values.push_back(i % 3 == 0 ? -value : value);
+    }
+
+    ExecutionPolicy const parallel{.threads = 4, .parallel_threshold = 1};
+
+    SECTION("Product")
+    {
+        BigInt expected(1);
+
+        for (BigInt const &value : values)
+        {
+            expected *= value;
+        }
+
+        REQUIRE(reduce_product(values) == expected);
+        REQUIRE(reduce_product(values, parallel) == expected);
+        BigInt const first_five = values[0] * values[1] * values[2] * values[3] * values[4];
+        REQUIRE(reduce_product(std::span(values).first(5), parallel) == first_five);
+        REQUIRE(reduce_product({}) == 1_bi);
+        REQUIRE(reduce_product(std::span(values).first(1)) == values.front());
+
+        values[1234] = BigInt();
+        REQUIRE(reduce_product(values, parallel) == BigInt());
+    }
+
+    SECTION("Sum")
+    {
+        BigInt expected;
+
+        for (BigInt const &value : values)
+        {
+            expected += value;
+        }
+
+        REQUIRE(reduce_sum(values) == expected);
+        REQUIRE(reduce_sum(values, parallel) == expected);
+        REQUIRE(reduce_sum({}) == BigInt());
+        REQUIRE(reduce_sum(std::span(values).first(3), parallel) == values[0] + values[1] + values[2]);
+
+        // Carries out of every chunk, many times over.
+        std::vector<BigInt> const all_ones(1000, (1_bi << 640) - 1_bi);
+        REQUIRE(reduce_sum(all_ones, parallel) == BigInt(1000) * ((1_bi << 640) - 1_bi));
+
+        // Sums that cancel out.
+        std::vector<BigInt> opposite{(1_bi << 200), -(1_bi << 200), 5_bi, -5_bi};
+        REQUIRE(reduce_sum(opposite) == BigInt());
+    }
+}
+
+TEST_CASE("BigInt Accumulator")
+{
+    SECTION("Empty")
+    {
+        REQUIRE(Accumulator().result() == BigInt());
+    }
+
+    SECTION("Mixed signs")
+    {
+        Accumulator accumulator;
+        BigInt expected;
+
+        for (std::int64_t i = 1; i <= 3000; ++i)
+        {
+            BigInt const value = (BigInt(i) << static_cast<size_t>(i % 300)) * BigInt(i % 5 == 0 ? -1 : 1);
+
+            if (i % 4 == 0)
+            {
+                accumulator -= value;
+                expected -= value;
+            }
+            else
+            {
+                accumulator += value;
+                expected += value;
+            }
+        }
+
+        REQUIRE(accumulator.result() == expected);
+        // result() doesn't change the accumulated sum.
+        accumulator += 1_bi;
+        REQUIRE(accumulator.result() == expected + 1_bi);
+    }
+
+    SECTION("Carries")
+    {
+        BigInt const all_ones = (1_bi << 1024) - 1_bi;
+        Accumulator accumulator;
+
+        for (size_t i = 0; i < 5000; ++i)
+        {
+            accumulator += all_ones;
+        }
+
+        accumulator += 1_bi;
+        REQUIRE(accumulator.result() == (BigInt(5000) * all_ones) + 1_bi);
+
+        accumulator -= BigInt(5000) * all_ones;
+        REQUIRE(accumulator.result() == 1_bi);
+    }
+
+    SECTION("Merge and clear")
+    {
+        Accumulator first;
+        Accumulator second;
+        first += (1_bi << 500);
+        first -= 7_bi;
+        second += -(1_bi << 600);
+        second -= -3_bi;
+
+        first.merge(second);
+        REQUIRE(first.result() == (1_bi << 500) - (1_bi << 600) - 4_bi);
+        REQUIRE(second.result() == -(1_bi << 600) + 3_bi);
+
+        first.clear();
+        REQUIRE(first.result() == BigInt());
+        first += 42_bi;
+        REQUIRE(first.result() == 42_bi);
+    }
+}
+
+TEST_CASE("BigInt Division and Modulo")
+{
+    BigInt c = 106048574244834508800_bi;
+    BigInt d = -429391241160_bi;
+
+    SECTION("BigInt Division")
+    {
+        REQUIRE(x / y == 1_bi);
+        REQUIRE(x / (-y) == -1_bi);
+        REQUIRE((-x) / y == -1_bi);
+        REQUIRE((-x) / (-y) == 1_bi);
+        REQUIRE(c / d == -246974237_bi);
+
+        SECTION("Division by zero")
+        {
+            REQUIRE_THROWS_AS(a / 0_bi, std::domain_error);
+        }
+    }
+
+    SECTION("BigInt Modulo")
+    {
+        REQUIRE(x % y == 368046011657180833755187620605837985211634426436_bi);
+        REQUIRE(x % (-y) == 368046011657180833755187620605837985211634426436_bi);
+        REQUIRE((-x) % y == -368046011657180833755187620605837985211634426436_bi);
+        REQUIRE((-x) % (-y) == -368046011657180833755187620605837985211634426436_bi);
+        REQUIRE(c % d == 84860513880_bi);
+
+        SECTION("Division by zero")
+        {
+            REQUIRE_THROWS_AS(x % 0_bi, std::domain_error);
+        }
+    }
+}
+
+TEST_CASE("BigInt Power")
+{
+    SECTION("Zero power")
+    {
+        REQUIRE(a.pow(0) == 1_bi);
+        REQUIRE((-a).pow(0) == 1_bi);
+    }
+
+    SECTION("Power of one")
+    {
+        REQUIRE(a.pow(1) == 1234567890_bi);
+        REQUIRE((-a).pow(1) == -1234567890_bi);
+    }
+
+    SECTION("Positive powers")
+    {
+        REQUIRE(a.pow(2) == 1524157875019052100_bi);
+        REQUIRE(a.pow(5) == 2867971860299718107233761438093672048294900000_bi);
+        REQUIRE(
+            a.pow(10) == 8225262591471025795047611436615355477641378922955141680937016996764162077997366010000000000_bi
+        );
+    }
+
+    SECTION("Negative base positive powers")
+    {
+        REQUIRE((-a).pow(2) == 1524157875019052100_bi);
+        REQUIRE((-a).pow(5) == -2867971860299718107233761438093672048294900000_bi);
+    }
+
+    SECTION("Edge cases")
+    {
+        REQUIRE((0_bi).pow(1000) == 0_bi);
+        REQUIRE((1_bi).pow(1000) == 1_bi);
         REQUIRE((0_bi).pow(0) == 1_bi);
     }
 }
 
+TEST_CASE("BigInt GCD")
+{
+    // Euclid's algorithm with the remainder operator, as a reference.
+    auto reference_gcd = [](BigInt u, BigInt v)
+    {
+        u = u.abs();
+        v = v.abs();
+
+        while (v != 0_bi)
+        {
+            u = std::exchange(v, u % v);
+        }
+
+        return u;
+    };
+
+    BigInt const g = 3_bi * 5_bi * z.pow(3);
+    std::vector<BigInt> const values{
+        0_bi, 1_bi, 6_bi, 35_bi, a, b_neg, x, y_neg, z, x * y, g * x, g * y_neg, (1_bi << 500) * y, (1_bi << 300),
+        x.pow(20), y.pow(21) + 1_bi, g * (x.pow(5) + 7_bi)
+    };
+
+    SECTION("gcd")
+    {
+        REQUIRE(gcd(0_bi, 0_bi) == 0_bi);
+        REQUIRE(gcd(12_bi, -18_bi) == 6_bi);
+        REQUIRE(gcd(-(1_bi << 200), 1_bi << 130) == 1_bi << 130);
+        REQUIRE(gcd(g * x, g * y) == g * gcd(x, y));
+
+        for (BigInt const &lhs : values)
+        {
+            for (BigInt const &rhs : values)
+            {
+                REQUIRE(gcd(lhs, rhs) == reference_gcd(lhs, rhs));
+            }
+        }
+    }
+
+    SECTION("lcm")
+    {
+        REQUIRE(lcm(4_bi, -6_bi) == 12_bi);
+        REQUIRE(lcm(0_bi, x) == 0_bi);
+        REQUIRE(lcm(g * x, g * y) == g * x * y / gcd(x, y));
+    }
+
+    SECTION("gcdext")
+    {
+        REQUIRE(gcdext(0_bi, 0_bi) == std::tuple{0_bi, 0_bi, 0_bi});
+        REQUIRE(gcdext(-7_bi, 0_bi) == std::tuple{7_bi, -1_bi, 0_bi});
+
+        for (BigInt const &lhs : values)
+        {
+            for (BigInt const &rhs : values)
+            {
+                auto const [d, s, t] = gcdext(lhs, rhs);
+
+                REQUIRE(d == reference_gcd(lhs, rhs));
+                REQUIRE(lhs * s + rhs * t == d);
+
+                if (d != 0_bi)
+                {
+                    REQUIRE(s.abs() <= rhs.abs() / d + 1_bi);
+                    REQUIRE(t.abs() <= lhs.abs() / d + 1_bi);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("BigInt Modular exponentiation")
+{
+    // 2^127 - 1 and 2^521 - 1 are prime.
+    BigInt const p127 = (1_bi << 127) - 1_bi;
+    BigInt const p521 = (1_bi << 521) - 1_bi;
+    std::vector<BigInt> const moduli{3_bi, 1000000007_bi, 1_bi << 64, p127, p521, x, y, z * 2_bi, z.pow(9)};
+
+    SECTION("Small exponents match pow")
+    {
+        for (BigInt const &m : moduli)
+        {
+            for (BigInt const &base : {0_bi, 1_bi, 2_bi, a, b_neg, x_neg, z})
+            {
+                for (size_t power : {0, 1, 2, 5, 17, 64})
+                {
+                    BigInt expected = base.pow(power) % m;
+                    if (expected < 0_bi)
+                    {
+                        expected += m;
+                    }
+
+                    REQUIRE(powm(base, BigInt(power), m) == expected);
+                    REQUIRE(powm(base, BigInt(power), -m) == expected);
+
+                    if (m % 2_bi == 1_bi)
+                    {
+                        REQUIRE(powm_sec(base, BigInt(power), m) == expected);
+                    }
+                }
+            }
+        }
+    }
+
+    SECTION("Fermat's little theorem")
+    {
+        for (BigInt const &base : {2_bi, a, x, z})
+        {
+            REQUIRE(powm(base, p127 - 1_bi, p127) == 1_bi);
+            REQUIRE(powm(base, p521 - 1_bi, p521) == 1_bi);
+            REQUIRE(powm_sec(base, p521 - 1_bi, p521) == 1_bi);
+        }
+    }
+
+    SECTION("Large exponents")
+    {
+        for (BigInt const &m : moduli)
+        {
+            // (b^e1)^e2 = b^(e1 * e2).
+            BigInt const e1 = x;
+            BigInt const e2 = y;
+            REQUIRE(powm(powm(a, e1, m), e2, m) == powm(a, e1 * e2, m));
+            REQUIRE(powm(z, e1 + e2, m) == (powm(z, e1, m) * powm(z, e2, m)) % m);
+
+            if (m % 2_bi == 1_bi)
+            {
+                REQUIRE(powm_sec(z, e1 * e2, m) == powm(z, e1 * e2, m));
+            }
+        }
+    }
+
+    SECTION("Edge cases")
+    {
+        REQUIRE(powm(x, y, 1_bi) == 0_bi);
+        REQUIRE(powm(0_bi, 0_bi, x) == 1_bi);
+        REQUIRE(powm_sec(x, 0_bi, y) == 1_bi);
+        REQUIRE_THROWS_AS(powm(x, y, 0_bi), std::domain_error);
+        REQUIRE_THROWS_AS(powm(x, -y, z), std::domain_error);
+        REQUIRE_THROWS_AS(powm_sec(x, y, 1_bi << 64), std::domain_error);
+    }
+}
+
+TEST_CASE("BigInt Modular inverse")
+{
+    BigInt const p521 = (1_bi << 521) - 1_bi;
+    std::vector<BigInt> const moduli{7_bi, 1000000007_bi, 1_bi << 64, p521, x, z * 2_bi};
+
+    SECTION("Single inverse")
+    {
+        for (BigInt const &m : moduli)
+        {
+            for (BigInt const &value : {1_bi, 3_bi, a, b_neg, x_neg, z, p521 - 1_bi})
+            {
+                if (gcd(value, m) != 1_bi)
+                {
+                    REQUIRE_THROWS_AS(invert(value, m), std::domain_error);
+                    continue;
+                }
+
+                BigInt const inverse = invert(value, m);
+                REQUIRE(inverse >= 0_bi);
+                REQUIRE(inverse < m);
+                BigInt product = (value * inverse) % m;
+                REQUIRE((product < 0_bi ? product + m : product) == 1_bi);
+                REQUIRE(invert(value, -m) == inverse);
+            }
+        }
+
+        REQUIRE(invert(x, 1_bi) == 0_bi);
+        REQUIRE_THROWS_AS(invert(x, 0_bi), std::domain_error);
+        REQUIRE_THROWS_AS(invert(0_bi, x), std::domain_error);
+    }
+
+    SECTION("Batch inverse matches single inverses")
+    {
+        for (BigInt const &m : moduli)
+        {
+            std::vector<BigInt> values;
+
+            for (BigInt value = x_neg; values.size() < 50; value = value * 2_bi + 1_bi)
+            {
+                if (gcd(value, m) == 1_bi)
+                {
+                    values.push_back(value);
+                }
+            }
+
+            std::vector<BigInt> inverses = values;
+            batch_invert(inverses, m);
+
+            for (size_t i = 0; i < values.size(); ++i)
+            {
+                REQUIRE(inverses[i] == invert(values[i], m));
+            }
+        }
+    }
+
+    SECTION("Batch edge cases")
+    {
+        std::vector<BigInt> empty;
+        batch_invert(empty, x);
+        REQUIRE(empty.empty());
+
+        std::vector<BigInt> single{a};
+        batch_invert(single, p521);
+        REQUIRE(single[0] == invert(a, p521));
+
+        std::vector<BigInt> ones{a, x};
+        batch_invert(ones, 1_bi);
+        REQUIRE(ones == std::vector<BigInt>{0_bi, 0_bi});
+
+        std::vector<BigInt> const original{a, 0_bi, x};
+        std::vector<BigInt> values = original;
+        REQUIRE_THROWS_AS(batch_invert(values, p521), std::domain_error);
+        REQUIRE(values == original);
+        REQUIRE_THROWS_AS(batch_invert(values, 0_bi), std::domain_error);
+    }
+}
+
+TEST_CASE("BigInt Roots")
+{
+    SECTION("Square root")
+    {
+        for (BigInt const &num : {0_bi, 1_bi, 2_bi, 3_bi, 4_bi, a, b, x, y, z, z.pow(30), (1_bi << 64) - 1_bi})
+        {
+            auto const [root, rest] = sqrtrem(num);
+            REQUIRE(isqrt(num) == root);
+            REQUIRE(root * root + rest == num);
+            REQUIRE(rest >= 0_bi);
+            REQUIRE(rest <= root * 2_bi);
+        }
+
+        REQUIRE(isqrt(99_bi) == 9_bi);
+        REQUIRE(isqrt(100_bi) == 10_bi);
+        REQUIRE(isqrt(x * x) == x.abs());
+        REQUIRE(isqrt(x * x - 1_bi) == x.abs() - 1_bi);
+        REQUIRE_THROWS_AS(isqrt(-1_bi), std::domain_error);
+        REQUIRE_THROWS_AS(sqrtrem(x_neg), std::domain_error);
+    }
+
+    SECTION("K-th root")
+    {
+        for (size_t k : {1, 2, 3, 5, 8, 13, 100})
+        {
+            for (BigInt const &num : {a, b, x, y, z.pow(7)})
+            {
+                BigInt const r = root(num, k);
+                REQUIRE(r.pow(k) <= num);
+                REQUIRE((r + 1_bi).pow(k) > num);
+                REQUIRE(root(num.pow(k), k) == num);
+            }
+        }
+
+        REQUIRE(root(0_bi, 5) == 0_bi);
+        REQUIRE(root(1000_bi, 3) == 10_bi);
+        REQUIRE(root(999_bi, 3) == 9_bi);
+        REQUIRE(root(-1000_bi, 3) == -10_bi);
+        REQUIRE(root(-999_bi, 3) == -9_bi);
+        REQUIRE(root(x_neg.pow(3), 3) == x_neg);
+        REQUIRE(root(7_bi, 10) == 1_bi);
+        REQUIRE_THROWS_AS(root(x, 0), std::domain_error);
+        REQUIRE_THROWS_AS(root(x_neg, 4), std::domain_error);
+    }
+
+    SECTION("Perfect squares")
+    {
+        REQUIRE(is_perfect_square(0_bi));
+        REQUIRE(is_perfect_square(1_bi));
+        REQUIRE(is_perfect_square(1_bi << 64));
+        REQUIRE_FALSE(is_perfect_square(2_bi));
+        REQUIRE_FALSE(is_perfect_square(-4_bi));
+
+        for (BigInt const &num : {a, b, x, y, z})
+        {
+            BigInt const square = num * num;
+            REQUIRE(is_perfect_square(square));
+            REQUIRE_FALSE(is_perfect_square(square + 1_bi));
+            REQUIRE_FALSE(is_perfect_square(square - 1_bi));
+            REQUIRE_FALSE(is_perfect_square(square + (num.abs() * 2_bi) + 2_bi));
+        }
+    }
+
+    SECTION("Perfect powers")
+    {
+        for (BigInt const &num : {0_bi, 1_bi, -1_bi, 4_bi, 8_bi, -8_bi, 1_bi << 64, 1_bi << 67, -(1_bi << 67)})
+        {
+            REQUIRE(is_perfect_power(num));
+        }
+        for (BigInt const &num : {2_bi, 3_bi, 6_bi, -4_bi, -(1_bi << 64), (1_bi << 64) + 1_bi, 72_bi})
+        {
+            REQUIRE_FALSE(is_perfect_power(num));
+        }
+
+        for (size_t k : {2, 3, 5, 6, 7, 35})
+        {
+            REQUIRE(is_perfect_power(z.pow(k)));
+            REQUIRE_FALSE(is_perfect_power(z.pow(k) + 1_bi));
+        }
+
+        REQUIRE(is_perfect_power((111_bi).pow(1099)));
+        REQUIRE(is_perfect_power(-(111_bi).pow(1099)));
+        REQUIRE(is_perfect_power(((3_bi).pow(4) * (5_bi).pow(6)).pow(3)));
+        REQUIRE(is_perfect_power(-(12_bi).pow(9)));
+        REQUIRE_FALSE(is_perfect_power(-(12_bi).pow(8)));
+    }
+}
+
+TEST_CASE("BigInt Primality")
+{
+    SECTION("Small numbers")
+    {
+        constexpr size_t limit = 100000;
+        std::vector<bool> composite(limit);
+        composite[0] = composite[1] = true;
+
+        for (size_t i = 2; i * i < limit; ++i)
+        {
+            for (size_t j = i * i; !composite[i] && j < limit; j += i)
+            {
+                composite[j] = true;
+            }
+        }
+
+        std::vector<bool> not_prime(limit);
+
+        for (size_t i = 0; i < limit; ++i)
+        {
+            not_prime[i] = !is_probable_prime(BigInt(i));
+        }
+
+        REQUIRE(not_prime == composite);
+
+        REQUIRE_FALSE(is_probable_prime(-7_bi));
+    }
+
+    SECTION("Pseudoprimes")
+    {
+        // Strong pseudoprimes to base 2, Carmichael numbers and strong pseudoprimes to the first prime bases.
+        for (BigInt const &num : {2047_bi, 3277_bi, 5489641_bi, 27509653_bi, 27278026129_bi, 86483161466209_bi,
+                                  3215031751_bi, 3474749660383_bi, 341550071728321_bi, 3825123056546413051_bi,
+                                  318665857834031151167461_bi, 3317044064679887385961981_bi})
+        {
+            REQUIRE_FALSE(is_probable_prime(num));
+            REQUIRE_FALSE(is_probable_prime(num, 5));
+        }
+
+        // Strong Lucas pseudoprimes.
+        for (BigInt const &num : {5459_bi, 5777_bi, 10877_bi, 16109_bi, 18971_bi})
+        {
+            REQUIRE_FALSE(is_probable_prime(num));
+        }
+    }
+
+    SECTION("Large numbers")
+    {
+        BigInt const p521 = (1_bi << 521) - 1_bi;
+        BigInt const p607 = (1_bi << 607) - 1_bi;
+
+        REQUIRE(is_probable_prime(p521));
+        REQUIRE(is_probable_prime(p607, 10));
+        REQUIRE(is_probable_prime(1000000007_bi));
+        REQUIRE_FALSE(is_probable_prime((1_bi << 523) - 1_bi));
+        REQUIRE_FALSE(is_probable_prime(p521 * p607));
+        REQUIRE_FALSE(is_probable_prime(p521 * p521));
+        REQUIRE_FALSE(is_probable_prime(p521 * 1000000007_bi));
+        REQUIRE_FALSE(is_probable_prime(p521 + 1_bi));
+    }
+
+    SECTION("Next prime")
+    {
+        REQUIRE(next_prime(-10_bi) == 2_bi);
+        REQUIRE(next_prime(0_bi) == 2_bi);
+        REQUIRE(next_prime(2_bi) == 3_bi);
+        REQUIRE(next_prime(3_bi) == 5_bi);
+        REQUIRE(next_prime(65520_bi) == 65521_bi);
+        REQUIRE(next_prime(65521_bi) == 65537_bi);
+        REQUIRE(next_prime(1000000000_bi) == 1000000007_bi);
+        REQUIRE(next_prime(1_bi << 64) == (1_bi << 64) + 13_bi);
+        REQUIRE(next_prime((1_bi << 89) - 2_bi) == (1_bi << 89) - 1_bi);
+
+        BigInt const p = next_prime(x.abs());
+        REQUIRE(is_probable_prime(p));
+
+        for (BigInt i = x.abs() + 1_bi; i < p; i += 1_bi)
+        {
+            REQUIRE_FALSE(is_probable_prime(i));
+        }
+    }
+}
+
+TEST_CASE("BigInt Combinatorics")
+{
+    SECTION("Factorial")
+    {
+        BigInt expected(1);
+
+        for (std::uint64_t n = 0; n <= 600; ++n)
+        {
+            if (n > 0)
+            {
+                expected *= BigInt(n);
+            }
+
+            REQUIRE(factorial(n) == expected);
+        }
+
+        REQUIRE(factorial(25) == 15511210043330985984000000_bi);
+    }
+
+    SECTION("Binomial")
+    {
+        // Rows of Pascal's triangle.
+        std::vector<BigInt> row{1_bi};
+
+        for (std::uint64_t n = 1; n <= 150; ++n)
+        {
+            std::vector<BigInt> next(n + 1, 1_bi);
+
+            for (std::uint64_t k = 1; k < n; ++k)
+            {
+                next[k] = row[k - 1] + row[k];
+            }
+
+            row = std::move(next);
+
+            for (std::uint64_t k = 0; k <= n; ++k)
+            {
+                REQUIRE(binomial(n, k) == row[k]);
+            }
+        }
+
+        REQUIRE(binomial(0, 0) == 1_bi);
+        REQUIRE(binomial(5, 6) == 0_bi);
+        REQUIRE(binomial(1000, 500) == factorial(1000) / (factorial(500) * factorial(500)));
+        REQUIRE(binomial(1000, 37) == product(964, 1001) / factorial(37));
+        REQUIRE(binomial(UINT64_MAX, 1) == BigInt(UINT64_MAX));
+        REQUIRE(binomial(UINT64_MAX, 2) == BigInt(UINT64_MAX) * BigInt(UINT64_MAX - 1) / 2_bi);
+
+        // Small k for a huge n must not sieve the primes up to n.
+        for (std::uint64_t const n : {std::uint64_t{1} << 40, (std::uint64_t{1} << 50) + 7, UINT64_MAX})
+        {
+            for (std::uint64_t const k : {std::uint64_t{20}, std::uint64_t{100}})
+            {
+                BigInt expected(1);
+
+                for (std::uint64_t i = 1; i <= k; ++i)
+                {
+                    expected = (expected * BigInt(n - k + i)) / BigInt(i);
+                }
+
+                REQUIRE(binomial(n, k) == expected);
+                REQUIRE(binomial(n, n - k) == expected);
+            }
+        }
+    }
+
+    SECTION("Primorial and product")
+    {
+        REQUIRE(primorial(0) == 1_bi);
+        REQUIRE(primorial(1) == 1_bi);
+        REQUIRE(primorial(2) == 2_bi);
+        REQUIRE(primorial(30) == 6469693230_bi);
+        REQUIRE(primorial(100) == 2305567963945518424753102147331756070_bi);
+
+        REQUIRE(product(5, 10) == 15120_bi);
+        REQUIRE(product(10, 5) == 1_bi);
+        REQUIRE(product(7, 7) == 1_bi);
+        REQUIRE(product(0, 5) == 0_bi);
+        REQUIRE(product(1, 501) == factorial(500));
+        REQUIRE(product(300, 1000) * factorial(299) == factorial(999));
+    }
+}
+
+TEST_CASE("BigInt Batch")
+{
+    constexpr size_t limbs = 4;
+    constexpr size_t lanes = 150;
+    BigInt const modulus = 1_bi << (limbs * 64);
+
+    // Numbers of every size up to the full width, including the largest one.
+    std::vector<BigInt> lhs_values;
+    std::vector<BigInt> rhs_values;
+    std::uint64_t seed = 12345;
+
+    for (size_t i = 0; i < lanes; ++i)
+    {
+        BigInt const lhs = random_number(seed, limbs);
+        BigInt const rhs = random_number(seed, limbs);
+
+        lhs_values.push_back(lhs >> (i % 256));
+        rhs_values.push_back(i % 10 == 0 ? lhs_values.back() : rhs >> ((i * 7) % 256));
+    }
+
+    lhs_values[1] = modulus - 1_bi;
+    rhs_values[1] = modulus - 1_bi;
+    rhs_values[2] = BigInt();
+
+    Batch<limbs> const lhs(lhs_values);
+    Batch<limbs> const rhs(rhs_values);
+
+    SECTION("Conversion")
+    {
+        REQUIRE(lhs.size() == lanes);
+        REQUIRE(lhs.values() == lhs_values);
+        REQUIRE(rhs.get(2) == BigInt());
+
+        Batch<limbs> batch(3);
+        REQUIRE(batch.get(1) == BigInt());
+        batch.set(1, 42_bi);
+        REQUIRE(batch.get(1) == 42_bi);
+        REQUIRE(batch.limb(0)[1] == 42);
+
+        REQUIRE_THROWS_AS(batch.set(3, 1_bi), std::out_of_range);
+        REQUIRE_THROWS_AS(batch.get(3), std::out_of_range);
+        REQUIRE_THROWS_AS(batch.set(0, -1_bi), std::domain_error);
+        REQUIRE_THROWS_AS(batch.set(0, modulus), std::overflow_error);
+        REQUIRE_THROWS_AS(batch + lhs, std::invalid_argument);
+    }
+
+    SECTION("Arithmetic")
+    {
+        std::vector<BigInt> const sums = (lhs + rhs).values();
+        std::vector<BigInt> const differences = (lhs - rhs).values();
+        std::vector<BigInt> const products = (lhs * rhs).values();
+        std::vector<BigInt> const wide_products = wide_multiply(lhs, rhs).values();
+
+        for (size_t i = 0; i < lanes; ++i)
+        {
+            BigInt const &a = lhs_values[i];
+            BigInt const &b = rhs_values[i];
+
+            REQUIRE(sums[i] == (a + b) % modulus);
+            REQUIRE(differences[i] == (a - b + modulus) % modulus);
+            REQUIRE(products[i] == (a * b) % modulus);
+            REQUIRE(wide_products[i] == a * b);
+        }
+
+        Batch<limbs> accumulated = lhs;
+        accumulated += rhs;
+        accumulated -= rhs;
+        REQUIRE(accumulated.values() == lhs_values);
+    }
+
+    SECTION("Comparison")
+    {
+        std::vector<std::strong_ordering> const orderings = compare(lhs, rhs);
+
+        for (size_t i = 0; i < lanes; ++i)
+        {
+            REQUIRE(orderings[i] == (lhs_values[i] <=> rhs_values[i]));
+        }
+    }
+}
+
+TEST_CASE("BigInt FixedInt")
+{
+    using U256 = FixedInt<256>;
+    using I128 = FixedInt<128, true>;
+    using U100 = FixedInt<100>;
+
+    // Everything but the conversions runs at compile time.
+    static_assert((U256(3) * U256(5)).get_limbs()[0] == 15);
+    static_assert(U256(0) - U256(1) == U256::max());
+    static_assert((U256(1) << 255) + (U256(1) << 255) == U256());
+    static_assert(I128(-7) / I128(2) == I128(-3));
+    static_assert(I128(-7) % I128(2) == I128(-1));
+    static_assert(I128(-1) < I128(0));
+    static_assert(I128::min() < I128::max());
+    static_assert((I128(-16) >> 2) == I128(-4));
+    static_assert(U100::max().get_limbs()[1] == (1ULL << 36) - 1);
+
+    BigInt const modulus = 1_bi << 256;
+    std::uint64_t seed = 987654321;
+
+    SECTION("Unsigned arithmetic")
+    {
+        for (size_t i = 0; i < 200; ++i)
+        {
+            BigInt const a = random_number(seed, 4) >> (i % 200);
+            BigInt const b = random_number(seed, 4) >> ((i * 13) % 250);
+            U256 const x(a);
+            U256 const y(b);
+
+            REQUIRE((x + y).to_bigint() == (a + b) % modulus);
+            REQUIRE((x - y).to_bigint() == (a - b + modulus) % modulus);
+            REQUIRE((x * y).to_bigint() == (a * b) % modulus);
+            REQUIRE((x << (i % 300)).to_bigint() == (a << (i % 300)) % modulus);
+            REQUIRE((x >> (i % 300)).to_bigint() == (a >> (i % 300)));
+            REQUIRE((x <=> y) == (a <=> b));
+
+            if (b != BigInt())
+            {
+                REQUIRE((x / y).to_bigint() == a / b);
+                REQUIRE((x % y).to_bigint() == a % b);
+            }
+        }
+    }
+
+    SECTION("Signed arithmetic")
+    {
+        BigInt const half = 1_bi << 127;
+
+        for (size_t i = 0; i < 200; ++i)
+        {
+            BigInt a = random_number(seed, 2) >> ((i % 64) + 1);
+            BigInt b = random_number(seed, 2) >> ((i * 7 % 120) + 1);
+            a = i % 2 == 0 ? -a : a;
+            b = i % 3 == 0 ? -b : b;
+            I128 const x(a);
+            I128 const y(b);
+
+            // Wrap a result into [-2^127, 2^127).
+            auto wrap = [&](BigInt const &value)
+            {
+                BigInt result = ((value % (half * 2_bi)) + (half * 2_bi)) % (half * 2_bi);
+                return result >= half ? result - (half * 2_bi) : result;
+            };
+
+            REQUIRE(x.to_bigint() == a);
+            REQUIRE((x + y).to_bigint() == wrap(a + b));
+            REQUIRE((x - y).to_bigint() == wrap(a - b));
+            REQUIRE((x * y).to_bigint() == wrap(a * b));
+            REQUIRE((-x).to_bigint() == -a);
+            REQUIRE((x <=> y) == (a <=> b));
+
+            if (b != BigInt())
+            {
+                REQUIRE((x / y).to_bigint() == a / b);
+                REQUIRE((x % y).to_bigint() == a % b);
+            }
+        }
+
+        REQUIRE(I128::min().to_bigint() == -half);
+        REQUIRE(I128::max().to_bigint() == half - 1_bi);
+        REQUIRE(I128(-half) == I128::min());
+    }
+
+    SECTION("Conversions")
+    {
+        REQUIRE(U100(-1) == U100::max());
+        REQUIRE(U100::max().to_bigint() == (1_bi << 100) - 1_bi);
+        REQUIRE(I128(-5).to_bigint() == -5_bi);
+        REQUIRE(static_cast<BigInt>(U256(42)) == 42_bi);
+
+        REQUIRE_THROWS_AS(U100(1_bi << 100), std::overflow_error);
+        REQUIRE_THROWS_AS(U256(-1_bi), std::overflow_error);
+        REQUIRE_THROWS_AS(I128(1_bi << 127), std::overflow_error);
+        REQUIRE_THROWS_AS(I128(-(1_bi << 127) - 1_bi), std::overflow_error);
+        REQUIRE_THROWS_AS(U256(1) / U256(), std::domain_error);
+
+        REQUIRE(U256("0xFF") == U256(255));
+        REQUIRE(I128("-123456789012345678901234567890").to_bigint() == -123456789012345678901234567890_bi);
+        REQUIRE_THROWS_AS(U256("12x"), std::invalid_argument);
+
+        REQUIRE(std::format("{}", I128(-255)) == "-255");
+        REQUIRE(std::format("{:#x}", U256(255)) == "0xff");
+        REQUIRE(I128(-42).to_string() == "-42");
+
+        std::ostringstream stream;
+        stream << U100(1234);
+        REQUIRE(stream.str() == "1234");
+    }
+}
+
+TEST_CASE("BigInt Lazy expressions")
+{
+    BigInt const a("123456789012345678901234567890123456789");
+    BigInt const b("-98765432109876543210987654321");
+    BigInt const c("340282366920938463463374607431768211457");
+    BigInt const d("-1");
+    BigInt const m("1000000007000000009");
+
+    SECTION("Sums of products")
+    {
+        BigInt r;
+        r = lazy(a) * b + lazy(c) * d;
+        REQUIRE(r == a * b + c * d);
+        r = lazy(a) * b - lazy(c) * d - a;
+        REQUIRE(r == a * b - c * d - a);
+        r = (lazy(a) * b + lazy(c) * d) % m;
+        REQUIRE(r == (a * b + c * d) % m);
+        r = (lazy(a) + b) * (lazy(c) - d) / m;
+        REQUIRE(r == (a + b) * (c - d) / m);
+        r = -(lazy(a) * b) + c;
+        REQUIRE(r == -(a * b) + c);
+
+        BigInt const constructed = lazy(a) * a * a + 1;
+        REQUIRE(constructed == a * a * a + BigInt(1));
+    }
+
+    SECTION("Small numbers and shifts")
+    {
+        BigInt r;
+        r = lazy(a) * 2 + b;
+        REQUIRE(r == a * BigInt(2) + b);
+        r = 3 * lazy(b) - 7;
+        REQUIRE(r == BigInt(3) * b - BigInt(7));
+        r = (lazy(a) << 100) + (lazy(b) << 64) - c;
+        REQUIRE(r == (a << 100) + (b << 64) - c);
+        r = lazy(c) * -1 + c;
+        REQUIRE(r == 0);
+        r = lazy(a) * 0 + 0;
+        REQUIRE(r == 0);
+        r = lazy(b) - b;
+        REQUIRE(r == 0);
+        REQUIRE(-r == 0);
+    }
+
+    SECTION("Signs and carries")
+    {
+        BigInt const max = (1_bi << 256) - BigInt(1);
+        std::vector<BigInt> const values{0_bi, 1_bi, -1_bi, max, -max, max * max, -(max * max), BigInt(-123)};
+
+        for (BigInt const &x : values)
+        {
+            for (BigInt const &y : values)
+            {
+                BigInt r;
+                r = lazy(x) * y + x - y;
+                REQUIRE(r == x * y + x - y);
+                r = (lazy(x) << 3) - lazy(y) * 5;
+                REQUIRE(r == (x << 3) - y * BigInt(5));
+            }
+        }
+    }
+
+    SECTION("Aliasing")
+    {
+        BigInt x = a;
+        BigInt y = b;
+
+        for (int i = 0; i < 50; ++i)
+        {
+            BigInt const expected = x * BigInt(2) + y;
+            x = lazy(x) * 2 + y;
+            REQUIRE(x == expected);
+        }
+
+        BigInt const expected_square = x * x - x;
+        x = lazy(x) * x - x;
+        REQUIRE(x == expected_square);
+
+        x = a;
+        x = (lazy(x) << 70) + x;
+        REQUIRE(x == (a << 70) + a);
+
+        x = a;
+        x = lazy(b) * c % x;
+        REQUIRE(x == b * c % a);
+
+        REQUIRE_THROWS_AS(x = lazy(a) % 0, std::domain_error);
+    }
+
+    SECTION("Storage reuse")
+    {
+        BigInt r = lazy(a) * b + c;
+        BigInt::ChunkType const *const data = BigIntView(r).chunks().data();
+
+        r = lazy(a) + b;
+        REQUIRE(r == a + b);
+        r = lazy(r) * 3 - c;
+        REQUIRE(r == (a + b) * BigInt(3) - c);
+        REQUIRE(BigIntView(r).chunks().data() == data);
+    }
+}
+
+TEST_CASE("BigInt SharedBigInt")
+{
+    BigInt const value = (3_bi).pow(5000);
+
+    SECTION("Sharing")
+    {
+        SharedBigInt const empty;
+        REQUIRE(empty.use_count() == 0);
+        REQUIRE(BigIntView(empty) == 0_bi);
+        REQUIRE(empty.get() == 0);
+
+        SharedBigInt const shared(value);
+        SharedBigInt const copy = shared;
+        REQUIRE(shared.use_count() == 2);
+        REQUIRE(BigIntView(copy) == value);
+        REQUIRE(BigIntView(copy).chunks().data() == BigIntView(shared).chunks().data());
+
+        SharedBigInt moved = copy;
+        SharedBigInt const target = std::move(moved);
+        REQUIRE(shared.use_count() == 3);
+        REQUIRE(moved.use_count() == 0);
+
+        {
+            SharedBigInt const scoped = shared;
+            REQUIRE(shared.use_count() == 4);
+        }
+        REQUIRE(shared.use_count() == 3);
+    }
+
+    SECTION("Copy on write")
+    {
+        SharedBigInt a(value);
+        SharedBigInt b = a;
+
+        b.mutate() += 1_bi;
+        REQUIRE(BigIntView(a) == value);
+        REQUIRE(BigIntView(b) == value + 1_bi);
+        REQUIRE(a.use_count() == 1);
+        REQUIRE(b.use_count() == 1);
+
+        // Unique numbers are modified in place.
+        BigInt const *const number = &b.get();
+        REQUIRE(&b.mutate() == number);
+        b.mutate() -= 1_bi;
+        REQUIRE(BigIntView(b) == value);
+
+        SharedBigInt c = a;
+        c = BigInt(42);
+        REQUIRE(BigIntView(a) == value);
+        REQUIRE(BigIntView(c) == 42_bi);
+        c = a;
+        REQUIRE(a.use_count() == 2);
+
+        SharedBigInt d;
+        d.mutate() = 7_bi;
+        REQUIRE(BigIntView(d) == 7_bi);
+    }
+
+    SECTION("Views and formatting")
+    {
+        SharedBigInt const modulus(1'000'000'007_bi);
+        SharedBigInt const shared(value);
+
+        REQUIRE(powm(2_bi, 10_bi, modulus) == 1024);
+        REQUIRE(BigInt(BigIntView(shared) % modulus) == value % 1'000'000'007_bi);
+        REQUIRE(gcd(shared, modulus) == 1);
+        REQUIRE(std::format("{:x}", modulus) == "3b9aca07");
+        REQUIRE(std::hash<SharedBigInt>()(shared) == std::hash<BigInt>()(value));
+
+        std::ostringstream stream;
+        stream << modulus;
+        REQUIRE(stream.str() == "1000000007");
+    }
+
+    SECTION("Threads")
+    {
+        SharedBigInt const constant(value);
+
+        size_t const failures = count_thread_failures(
+            4,
+            200,
+            [&constant, &value](size_t /*thread*/, size_t /*iteration*/)
+            {
+                SharedBigInt copy = constant;
+                bool const unchanged = BigIntView(copy) == value;
+                copy.mutate() += 1_bi;
+                return unchanged;
+            }
+        );
+
+        REQUIRE(failures == 0);
+        REQUIRE(constant.use_count() == 1);
+        REQUIRE(BigIntView(constant) == value);
+    }
+}
+
+TEST_CASE("BigInt Power cache")
+{
+    SECTION("Values")
+    {
+        for (BigInt::ChunkType const base : {2U, 3U, 10U, 16U, 36U, 1'000'000'007U})
+        {
+            for (size_t const exponent : {size_t{0}, size_t{1}, size_t{7}, size_t{64}, size_t{1000}, size_t{4097}})
+            {
+                REQUIRE(BigIntView(cached_power(base, exponent)) == BigInt(base).pow(exponent));
+            }
+        }
+
+        REQUIRE_THROWS_AS(cached_power(1, 5), std::invalid_argument);
+        REQUIRE_THROWS_AS(cached_power(0, 5), std::invalid_argument);
+    }
+
+    SECTION("Sharing")
+    {
+        clear_power_cache();
+        REQUIRE(get_power_cache_usage() == 0);
+
+        SharedBigInt const first = cached_power(10, 5000);
+        SharedBigInt const second = cached_power(10, 5000);
+        REQUIRE(BigIntView(first).chunks().data() == BigIntView(second).chunks().data());
+        REQUIRE(get_power_cache_usage() > 0);
+        REQUIRE(get_power_cache_usage() <= get_power_cache_limit());
+    }
+
+    SECTION("Limit")
+    {
+        // Restore the limit even if a check fails, so the other tests run with the default cache.
+        struct RestoreLimit
+        {
+            size_t limit;
+
+            ~RestoreLimit()
+            {
+                set_power_cache_limit(limit);
+            }
+        } const restore{get_power_cache_limit()};
+        REQUIRE(restore.limit == default_power_cache_limit);
+
+        set_power_cache_limit(4096);
+        REQUIRE(get_power_cache_usage() <= 4096);
+
+        SharedBigInt const large = cached_power(7, 100'000);
+        REQUIRE(BigIntView(large) == BigInt(7).pow(100'000));
+        REQUIRE(get_power_cache_usage() <= 4096);
+
+        // Converting large numbers keeps working with the cache disabled.
+        set_power_cache_limit(0);
+        REQUIRE(get_power_cache_usage() == 0);
+        BigInt const number = (3_bi).pow(20'000);
+        REQUIRE(BigInt(number.to_string()) == number);
+        REQUIRE(get_power_cache_usage() == 0);
+    }
+
+    SECTION("Digit counts")
+    {
+        // Padding small numbers counts their digits, which must not fill the cache with one-off powers.
+        clear_power_cache();
+        BigInt power = 1_bi;
+
+        for (size_t digits = 1; digits <= 600; ++digits)
+        {
+            BigInt const below = power * 10_bi - 1_bi;
+            power *= 10_bi;
+
+            REQUIRE(std::format("{:>700}", power).find_first_not_of(' ') == 700 - (digits + 1));
+            REQUIRE(std::format("{:>700}", below).find_first_not_of(' ') == 700 - digits);
+        }
+
+        REQUIRE(get_power_cache_usage() == 0);
+    }
+
+    SECTION("Threads")
+    {
+        clear_power_cache();
+
+        // Threads with the same base share the powers they compute, exponents go from 100 to about 3000.
+        size_t const failures = count_thread_failures(
+            4,
+            30,
+            [](size_t thread, size_t iteration)
+            {
+                BigInt::ChunkType const base = 3 + (thread % 2);
+                size_t const exponent = 100 + (97 * iteration);
+                return BigIntView(cached_power(base, exponent)) == BigInt(base).pow(exponent);
+            }
+        );
+
+        REQUIRE(failures == 0);
+        REQUIRE(get_power_cache_usage() <= get_power_cache_limit());
+    }
+}
+
+TEST_CASE("BigInt Async")
+{
+    // About 10^4 chunks, so the multiplications, divisions and conversions are split.
+    BigInt const large = (3_bi).pow(400'000);
+
+    SECTION("Power")
+    {
+        REQUIRE(pow_async(BigInt(3), 400'000).get() == large);
+        REQUIRE(pow_async(BigInt(-7), 30'001).get() == BigInt(-7).pow(30'001));
+        REQUIRE(pow_async(large, 3).get() == large * large * large);
+        REQUIRE(pow_async(-large, 2).get() == large * large);
+        REQUIRE(pow_async(BigInt(5), 0).get() == 1);
+        REQUIRE(pow_async(BigInt(), 0).get() == 1);
+        REQUIRE(pow_async(BigInt(), 5).get() == 0);
+    }
+
+    SECTION("Division")
+    {
+        BigInt const denom = (7_bi).pow(65'000) + 1_bi;
+
+        for (BigInt const &num : {large, -large, large + 12345_bi})
+        {
+            for (BigInt const &divisor : {denom, -denom, BigInt(10), large})
+            {
+                REQUIRE(div_async(num, divisor).get() == BigInt::div(num, divisor));
+            }
+        }
+
+        REQUIRE(div_async(BigInt(100), BigInt(7)).get() == std::pair{BigInt(14), BigInt(2)});
+        REQUIRE(div_async(BigInt(5), large).get() == std::pair{BigInt(), BigInt(5)});
+        REQUIRE_THROWS_AS(div_async(large, BigInt()).get(), std::domain_error);
+    }
+
+    SECTION("Conversion")
+    {
+        REQUIRE(to_string_async(large).get() == large.to_string());
+        REQUIRE(to_string_async(-large, 7).get() == (-large).to_string(7));
+        REQUIRE(to_string_async(large, 36, true).get() == large.to_string(36, true));
+        REQUIRE(to_string_async(large, 16).get() == large.to_string(16));
+        REQUIRE(to_string_async(BigInt(-42)).get() == "-42");
+        REQUIRE(to_string_async(BigInt()).get() == "0");
+
+        // The lower parts of a power of the base are 0 and only made of padding.
+        BigInt const power = (10_bi).pow(200'000);
+        REQUIRE(to_string_async(power).get() == power.to_string());
+
+        REQUIRE_THROWS_AS(to_string_async(large, 37).get(), std::invalid_argument);
+        REQUIRE_THROWS_AS(to_string_async(BigInt(5), 1).get(), std::invalid_argument);
+    }
+
+    SECTION("Products")
+    {
+        REQUIRE(product_async(1, 40'001).get() == product(1, 40'001));
+        REQUIRE(product_async(1000, 30'000).get() == product(1000, 30'000));
+        REQUIRE(product_async(5, 5).get() == 1);
+        REQUIRE(product_async(0, 5).get() == 0);
+
+        REQUIRE(factorial_async(60'000).get() == factorial(60'000));
+        REQUIRE(factorial_async(20).get() == factorial(20));
+        REQUIRE(factorial_async(0).get() == 1);
+
+        std::vector<BigInt> const values{large, 1_bi - large, BigInt(3), large * 7_bi, BigInt(-2)};
+        REQUIRE(reduce_product_async(values).get() == reduce_product(values));
+        REQUIRE(reduce_product_async({}).get() == 1);
+    }
+
+    SECTION("Progress")
+    {
+        std::vector<double> reports;
+        auto record = [&reports](double fraction) { reports.push_back(fraction); };
+
+        REQUIRE(factorial_async(60'000, {}, record).get() == factorial(60'000));
+        REQUIRE(reports.size() > 2);
+        REQUIRE(std::ranges::is_sorted(reports));
+        REQUIRE(reports.front() > 0);
+        REQUIRE(reports.back() == 1);
+
+        reports.clear();
+        REQUIRE(to_string_async(large, 10, false, {}, record).get() == large.to_string());
+        REQUIRE(reports.size() > 2);
+        REQUIRE(std::ranges::is_sorted(reports));
+        REQUIRE(reports.back() == 1);
+
+        // Conversions that don't need to be split only report their end.
+        reports.clear();
+        REQUIRE(to_string_async(BigInt(243), 10, false, {}, record).get() == "243");
+        REQUIRE(reports == std::vector<double>{1});
+    }
+
+    SECTION("Cancellation")
+    {
+        std::stop_source stopped;
+        stopped.request_stop();
+        std::stop_token const token = stopped.get_token();
+
+        REQUIRE_THROWS_AS(pow_async(BigInt(3), 1'000'000, token).get(), OperationCancelled);
+        REQUIRE_THROWS_AS(div_async(large, BigInt(7), token).get(), OperationCancelled);
+        REQUIRE_THROWS_AS(to_string_async(large, 10, false, token).get(), OperationCancelled);
+        REQUIRE_THROWS_AS(product_async(1, 40'001, token).get(), OperationCancelled);
+        REQUIRE_THROWS_AS(factorial_async(60'000, token).get(), OperationCancelled);
+        REQUIRE_THROWS_AS(reduce_product_async({large, large}, token).get(), OperationCancelled);
+
+        // A stop requested while the operation runs is noticed before the next piece of work.
+        std::stop_source running;
+        size_t reports = 0;
+        auto future = pow_async(
+            BigInt(3),
+            size_t{1} << 24,
+            running.get_token(),
+            [&running, &reports](double)
+            {
+                ++reports;
+                running.request_stop();
+            }
+        );
+        REQUIRE_THROWS_AS(future.get(), OperationCancelled);
+        REQUIRE(reports == 1);
+    }
+}
+
+TEST_CASE("BigInt Modular context")
+{
+    BigInt const p521 = (1_bi << 521) - 1_bi;
+    ModContext<9> const context(p521);
+
+    auto reduce = [&](BigInt const &value)
+    {
+        BigInt result = value % p521;
+        return result < 0_bi ? result + p521 : result;
+    };
+
+    SECTION("Conversions")
+    {
+        for (BigInt const &value : {0_bi, 1_bi, a, b_neg, x, x_neg, z, p521, p521 + 1_bi, z.pow(20)})
+        {
+            REQUIRE(context.value(context.residue(value)) == reduce(value));
+        }
+
+        REQUIRE(context.value(context.one()) == 1_bi);
+        REQUIRE(context.modulus() == p521);
+        REQUIRE(context.size() == 9);
+    }
+
+    SECTION("Arithmetic")
+    {
+        for (BigInt const &lhs : {0_bi, 1_bi, a, x_neg, y, z})
+        {
+            for (BigInt const &rhs : {0_bi, 2_bi, b_neg, x, p521 - 1_bi})
+            {
+                ModInt<9> const l(context, lhs);
+                ModInt<9> const r(context, rhs);
+                REQUIRE((l + r).value() == reduce(lhs + rhs));
+                REQUIRE((l - r).value() == reduce(lhs - rhs));
+                REQUIRE((l * r).value() == reduce(lhs * rhs));
+                REQUIRE(context.value(context.sqr(l.get_residue())) == reduce(lhs * lhs));
+            }
+        }
+    }
+
+    SECTION("Power and inverse")
+    {
+        for (BigInt const &base : {2_bi, a, x, z})
+        {
+            ModInt<9> const value(context, base);
+            REQUIRE(value.pow(p521 - 1_bi).value() == 1_bi);
+            REQUIRE(value.pow(y).value() == powm(base, y, p521));
+            REQUIRE(value.pow(0_bi).value() == 1_bi);
+            REQUIRE((value * value.inv()).value() == 1_bi);
+            REQUIRE((value.pow(-y) * value.pow(y)).value() == 1_bi);
+            REQUIRE((value / value).value() == 1_bi);
+        }
+    }
+
+    SECTION("Small modulus")
+    {
+        ModContext<4> const small(1000000007_bi);
+        ModInt<4> const value(small, 123456789_bi);
+        REQUIRE(small.size() == 1);
+        REQUIRE((value * value).value() == 123456789_bi * 123456789_bi % 1000000007_bi);
+        REQUIRE(value.pow(1000000005_bi) == value.inv());
+    }
+
+    SECTION("Invalid moduli and residues")
+    {
+        REQUIRE_THROWS_AS(ModContext<1>(1_bi << 63), std::domain_error);
+        REQUIRE_THROWS_AS(ModContext<1>(1_bi), std::domain_error);
+        REQUIRE_THROWS_AS(ModContext<8>(p521), std::overflow_error);
+
+        ModContext<1> const composite(15_bi);
+        REQUIRE_THROWS_AS(ModInt<1>(composite, 6_bi).inv(), std::domain_error);
+        REQUIRE(ModInt<1>(composite, 7_bi).inv().value() == 13_bi);
+    }
+}
+
 TEST_CASE("BigInt std::format")
 {
     SECTION("No format specifier")
@@ -475,4 +2430,77 @@ TEST_CASE("BigInt std::format")
         REQUIRE(std::format("{:d}", 1234567890_bi) == "1234567890");
         REQUIRE(std::format("{:d}", -1234567890_bi) == "-1234567890");
     }
+
+    SECTION("Zero")
+    {
+        REQUIRE(std::format("{}", 0_bi) == "0");
+        REQUIRE(std::format("{}", -0_bi) == "0");
+        REQUIRE(std::format("{:#x}", 0_bi) == "0x0");
+        REQUIRE(std::format("{:#o}", 0_bi) == "0");
+    }
+
+    SECTION("Large numbers")
+    {
+        REQUIRE(std::format("{}", z) == z_str);
+        REQUIRE(std::format("{}", z_neg) == "-" + z_str);
+        REQUIRE(std::format("{:o}", x) == "115276051465043523552261111152454711711524132743033025");
+        REQUIRE(std::format("{:x}", x) == "9abe14cd44753b52c4926a9672793542d78c3615");
+    }
+
+    SECTION("Sign")
+    {
+        REQUIRE(std::format("{:+}", 1234567890_bi) == "+1234567890");
+        REQUIRE(std::format("{:+}", -1234567890_bi) == "-1234567890");
+        REQUIRE(std::format("{: }", 1234567890_bi) == " 1234567890");
+        REQUIRE(std::format("{:-}", 1234567890_bi) == "1234567890");
+    }
+
+    SECTION("Width and alignment")
+    {
+        REQUIRE(std::format("{:12}", 1234567890_bi) == "  1234567890");
+        REQUIRE(std::format("{:<12}", 1234567890_bi) == "1234567890  ");
+        REQUIRE(std::format("{:^13}", 1234567890_bi) == " 1234567890  ");
+        REQUIRE(std::format("{:>12}", -1234567890_bi) == " -1234567890");
+        REQUIRE(std::format("{:*^14}", -1234567890_bi) == "*-1234567890**");
+        REQUIRE(std::format("{:5}", 1234567890_bi) == "1234567890");
+        REQUIRE(std::format("{:{}}", 1234567890_bi, 12) == "  1234567890");
+        REQUIRE(std::format("{0:{1}x}", 255_bi, 4) == "  ff");
+    }
+
+    SECTION("Zero padding")
+    {
+        REQUIRE(std::format("{:012}", -1234567890_bi) == "-01234567890");
+        REQUIRE(std::format("{:#010x}", 255_bi) == "0x000000ff");
+        REQUIRE(std::format("{:<06}", 255_bi) == "255   ");
+    }
+
+    SECTION("Locale grouping")
+    {
+        REQUIRE(std::format("{:L}", 1234567890_bi) == "1234567890");
+
+        struct Grouping : std::numpunct<char>
+        {
+            [[nodiscard]] auto do_thousands_sep() const -> char override
+            {
+                return '\'';
+            }
+
+            [[nodiscard]] auto do_grouping() const -> std::string override
+            {
+                return "\3";
+            }
+        };
+
+        std::locale const locale(std::locale::classic(), new Grouping);
+        REQUIRE(std::format(locale, "{:L}", 1234567890_bi) == "1'234'567'890");
+        REQUIRE(std::format(locale, "{:L}", -123456_bi) == "-123'456");
+        REQUIRE(std::format(locale, "{:L}", 123_bi) == "123");
+        REQUIRE(std::format(locale, "{:>15L}", 1234567890_bi) == "  1'234'567'890");
+    }
+
+    SECTION("Invalid format specifiers")
+    {
+        REQUIRE_THROWS_AS(std::vformat("{:.2}", std::make_format_args(a)), std::format_error);
+        REQUIRE_THROWS_AS(std::vformat("{:q}", std::make_format_args(a)), std::format_error);
+    }
 }